@@ -11,15 +11,22 @@ $(1)_ASSETS := $$(wildcard applications/$($(1)_NAME)/*.markup) \
 
 $(1)_ASSETS := $$(patsubst applications/$($(1)_NAME)/%, $(BUILD_DIRECTORY_APPS)/$($(1)_NAME)/%, $$($(1)_ASSETS))
 
+$(1)_BITMAPS := $$(patsubst %.png, %.bitmap, $$(filter %.png, $$($(1)_ASSETS)))
+
 $(1)_OBJECTS = $$(patsubst applications/%.cpp, $$(BUILD_DIRECTORY)/applications/%.o, $$($(1)_SOURCES))
 
-TARGETS += $$($(1)_BINARY) $$($(1)_ASSETS)
+TARGETS += $$($(1)_BINARY) $$($(1)_ASSETS) $$($(1)_BITMAPS)
 OBJECTS += $$($(1)_OBJECTS)
 
 $(BUILD_DIRECTORY_APPS)/$($(1)_NAME)/%: applications/$($(1)_NAME)/%
 	$$(DIRECTORY_GUARD)
 	cp $$< $$@
 
+$(BUILD_DIRECTORY_APPS)/$($(1)_NAME)/%.bitmap: applications/$($(1)_NAME)/%.png
+	$$(DIRECTORY_GUARD)
+	@echo [$(1)] [BitmapCompiler] $$(notdir $$@)
+	@bitmap-compiler.py $$< $$@
+
 $$($(1)_BINARY): $$($(1)_OBJECTS) $$(patsubst %, $$(BUILD_DIRECTORY_LIBS)/lib%.a, $$($(1)_LIBS) system) $(CRTS)
 	$$(DIRECTORY_GUARD)
 	@echo [$(1)] [LD] $($(1)_NAME)
@@ -0,0 +1,4 @@
+APPS += BENCHMARK
+
+BENCHMARK_NAME = benchmark
+BENCHMARK_LIBS = terminal widget graphic
@@ -0,0 +1,107 @@
+#include <libgraphic/Bitmap.h>
+#include <libsystem/core/CString.h>
+#include <libsystem/io/Stream.h>
+#include <libsystem/system/System.h>
+
+#include "benchmark/Benchmarks.h"
+
+struct AssetsWorkload
+{
+    const char *name;
+    const char *assets[16];
+};
+
+// The bitmaps loaded by these applications before their first frame.
+static AssetsWorkload _assets_workloads[] = {
+    {
+        "panel",
+        {
+            "/Files/Fonts/sans",
+            "/Files/Icons/menu@18px",
+            "/Files/Icons/application@18px",
+            "/Files/Icons/window-minimize@18px",
+            "/Files/Icons/window-maximize@18px",
+            "/Files/Icons/window-close@18px",
+            nullptr,
+        },
+    },
+    {
+        "menu",
+        {
+            "/Files/Fonts/sans",
+            "/Files/Icons/account@36px",
+            "/Files/Icons/folder@18px",
+            "/Files/Icons/cog@18px",
+            "/Files/Icons/power-standby@18px",
+            "/Files/Icons/information@24px",
+            "/Files/Icons/calculator@24px",
+            "/Files/Icons/duck@24px",
+            "/Files/Icons/folder-outline@24px",
+            "/Files/Icons/console@24px",
+            "/Files/Icons/text-box@24px",
+            "/Files/Icons/widgets@24px",
+            nullptr,
+        },
+    },
+    {
+        "file-manager",
+        {
+            "/Files/Fonts/sans",
+            "/Files/Icons/folder@18px",
+            "/Files/Icons/file@18px",
+            "/Files/Icons/arrow-left@18px",
+            "/Files/Icons/arrow-right@18px",
+            "/Files/Icons/arrow-up@18px",
+            "/Files/Icons/home@18px",
+            "/Files/Icons/refresh@18px",
+            "/Files/Icons/console@18px",
+            "/Files/Icons/laptop@18px",
+            "/Files/Icons/chevron-right@18px",
+            "/Files/Icons/bookmark@18px",
+            "/Files/Icons/bookmark-outline@18px",
+            nullptr,
+        },
+    },
+    {
+        "compositor",
+        {
+            "/Files/Wallpapers/mountains",
+            "/Files/Fonts/mono",
+            "/Files/Fonts/sans",
+            nullptr,
+        },
+    },
+};
+
+static uint assets_load(AssetsWorkload &workload, const char *extension, ResultOr<RefPtr<Bitmap>> (*load)(const char *path))
+{
+    uint start = system_get_ticks();
+
+    for (size_t i = 0; workload.assets[i]; i++)
+    {
+        char path[PATH_LENGTH] = {};
+        snprintf(path, PATH_LENGTH, "%s%s", workload.assets[i], extension);
+
+        auto bitmap_or_result = load(path);
+
+        if (!bitmap_or_result.success())
+        {
+            printf("    %s: failed to load %s\n", workload.name, path);
+        }
+    }
+
+    return system_get_ticks() - start;
+}
+
+void assets_benchmark()
+{
+    for (size_t i = 0; i < __array_length(_assets_workloads); i++)
+    {
+        auto &workload = _assets_workloads[i];
+
+        uint png = assets_load(workload, ".png", Bitmap::load_from_png);
+        uint raw = assets_load(workload, ".bitmap", Bitmap::load_from_raw);
+
+        printf("    %s: png %dms, raw %dms\n", workload.name, png, raw);
+    }
+}
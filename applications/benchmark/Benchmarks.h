@@ -0,0 +1,33 @@
+#pragma once
+
+#include <libsystem/Common.h>
+
+void compositing_benchmark();
+
+void wallpaper_benchmark();
+
+void text_benchmark();
+
+void fonts_benchmark();
+
+void vector_benchmark();
+
+void assets_benchmark();
+
+void blur_benchmark();
+
+void layout_benchmark();
+
+void table_benchmark();
+
+void text_model_benchmark();
+
+void terminal_benchmark();
+
+typedef void (*BenchmarkCallback)();
+
+struct Benchmark
+{
+    const char *name;
+    BenchmarkCallback callback;
+};
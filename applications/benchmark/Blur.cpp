@@ -0,0 +1,36 @@
+#include <libgraphic/Painter.h>
+#include <libsystem/io/Stream.h>
+#include <libsystem/system/System.h>
+
+#include "benchmark/Benchmarks.h"
+
+#define BLUR_SCREEN_WIDTH 1920
+#define BLUR_SCREEN_HEIGHT 1080
+#define BLUR_FRAME_COUNT 8
+
+static void blur_benchmark_region(Painter &painter, const char *name, Rectangle region, int radius)
+{
+    uint start = system_get_ticks();
+
+    for (int frame = 0; frame < BLUR_FRAME_COUNT; frame++)
+    {
+        painter.blur_rectangle(region, radius);
+    }
+
+    uint elapsed = system_get_ticks() - start;
+
+    printf("    %s %dx%d radius %d: %dms/frame\n", name, region.width(), region.height(), radius, elapsed / BLUR_FRAME_COUNT);
+}
+
+void blur_benchmark()
+{
+    auto screen = Bitmap::create_shared(BLUR_SCREEN_WIDTH, BLUR_SCREEN_HEIGHT).take_value();
+    Painter painter{screen};
+
+    painter.fill_checkboard(screen->bound(), 16, Colors::WHITE, Colors::CORNFLOWERBLUE);
+
+    blur_benchmark_region(painter, "header", Rectangle(640, 32), 8);
+    blur_benchmark_region(painter, "panel", Rectangle(BLUR_SCREEN_WIDTH, 38), 48);
+    blur_benchmark_region(painter, "menu", Rectangle(320, 700), 48);
+    blur_benchmark_region(painter, "screen", screen->bound(), 48);
+}
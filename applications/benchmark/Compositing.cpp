@@ -0,0 +1,109 @@
+#include <libgraphic/Painter.h>
+#include <libsystem/io/Stream.h>
+#include <libsystem/system/System.h>
+#include <libsystem/thread/WorkerPool.h>
+#include <libutils/Vector.h>
+
+#include "benchmark/Benchmarks.h"
+
+#define COMPOSITING_SCREEN_WIDTH 1920
+#define COMPOSITING_SCREEN_HEIGHT 1080
+#define COMPOSITING_WINDOW_COUNT 24
+#define COMPOSITING_FRAME_COUNT 8
+
+struct CompositingWindow
+{
+    Rectangle bound;
+    RefPtr<Bitmap> bitmap;
+};
+
+static void composite_tile(
+    Painter &painter,
+    Bitmap &wallpaper,
+    Vector<CompositingWindow> &windows,
+    Rectangle tile)
+{
+    painter.push();
+    painter.clip(tile);
+
+    painter.blit_bitmap_no_alpha(wallpaper, tile, tile);
+
+    windows.foreach ([&](auto &window) {
+        if (window.bound.colide_with(tile))
+        {
+            Rectangle destination = window.bound.clipped_with(tile);
+
+            Rectangle source(
+                destination.position() - window.bound.position(),
+                destination.size());
+
+            painter.blit_bitmap(*window.bitmap, source, destination);
+        }
+
+        return Iteration::CONTINUE;
+    });
+
+    painter.pop();
+}
+
+void compositing_benchmark()
+{
+    auto screen = Bitmap::create_shared(COMPOSITING_SCREEN_WIDTH, COMPOSITING_SCREEN_HEIGHT).take_value();
+    auto wallpaper = Bitmap::create_shared(COMPOSITING_SCREEN_WIDTH, COMPOSITING_SCREEN_HEIGHT).take_value();
+    wallpaper->clear(Colors::CORNFLOWERBLUE);
+
+    Vector<CompositingWindow> windows;
+
+    for (int i = 0; i < COMPOSITING_WINDOW_COUNT; i++)
+    {
+        Rectangle bound(
+            (i * 71) % (COMPOSITING_SCREEN_WIDTH - 640),
+            (i * 43) % (COMPOSITING_SCREEN_HEIGHT - 480),
+            640,
+            480);
+
+        auto bitmap = Bitmap::create_shared(bound.width(), bound.height()).take_value();
+        bitmap->clear(Colors::WHITE.with_alpha(0.75));
+
+        windows.push_back({bound, bitmap});
+    }
+
+    printf("%dx%d, %d translucent windows\n",
+           COMPOSITING_SCREEN_WIDTH,
+           COMPOSITING_SCREEN_HEIGHT,
+           COMPOSITING_WINDOW_COUNT);
+
+    // WorkerPool runs its jobs one after the other on the calling thread
+    // for now, so this only measures what splitting the frame costs.
+    printf("tiling overhead per tile size:\n");
+
+    WorkerPool workers{1};
+    Painter painter(screen);
+
+    for (int tile_size = 32; tile_size <= 512; tile_size *= 2)
+    {
+        Vector<Rectangle> tiles;
+
+        for (int y = 0; y < COMPOSITING_SCREEN_HEIGHT; y += tile_size)
+        {
+            for (int x = 0; x < COMPOSITING_SCREEN_WIDTH; x += tile_size)
+            {
+                Rectangle tile(x, y, tile_size, tile_size);
+                tiles.push_back(tile.clipped_with(screen->bound()));
+            }
+        }
+
+        uint start = system_get_ticks();
+
+        for (int frame = 0; frame < COMPOSITING_FRAME_COUNT; frame++)
+        {
+            workers.run(tiles.count(), [&](size_t index, size_t) {
+                composite_tile(painter, *wallpaper, windows, tiles[index]);
+            });
+        }
+
+        uint elapsed = system_get_ticks() - start;
+
+        printf("    %3dpx tiles (%4d): %dms/frame\n", tile_size, tiles.count(), elapsed / COMPOSITING_FRAME_COUNT);
+    }
+}
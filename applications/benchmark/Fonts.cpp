@@ -0,0 +1,56 @@
+#include <libgraphic/TrueTypeFont.h>
+#include <libsystem/io/Stream.h>
+#include <libsystem/system/System.h>
+
+#include "benchmark/Benchmarks.h"
+
+static void fonts_report(TrueTypeFont *font, int size, uint elapsed)
+{
+    TrueTypeFontStats stats = truetypefont_get_stats(font);
+
+    printf("    %dpx: %dms, %d/%d glyphs rasterized, %d page(s), %dKiB, %d eviction(s)\n",
+           size,
+           elapsed,
+           stats.rasterized_glyphs,
+           stats.glyphs,
+           stats.pages,
+           stats.memory / 1024,
+           stats.evictions);
+}
+
+void fonts_benchmark()
+{
+    uint start = system_get_ticks();
+    TrueTypeFamily *family = truetype_family_create("/Files/Fonts/Roboto/Roboto-Medium.ttf");
+    printf("    family loaded in %dms\n", system_get_ticks() - start);
+
+    printf("    ASCII:\n");
+
+    for (int size = 8; size <= 32; size += 4)
+    {
+        start = system_get_ticks();
+
+        TrueTypeFont *font = truetypefont_create(family, size);
+        truetypefont_raster_range(font, 0x0020, 0x007f);
+
+        fonts_report(font, size, system_get_ticks() - start);
+
+        truetypefont_destroy(font);
+    }
+
+    printf("    Latin, Greek and Cyrillic:\n");
+
+    for (int size = 16; size <= 64; size *= 2)
+    {
+        start = system_get_ticks();
+
+        TrueTypeFont *font = truetypefont_create(family, size);
+        truetypefont_raster_range(font, 0x0020, 0x04ff);
+
+        fonts_report(font, size, system_get_ticks() - start);
+
+        truetypefont_destroy(font);
+    }
+
+    truetype_family_destroy(family);
+}
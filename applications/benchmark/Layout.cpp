@@ -0,0 +1,68 @@
+#include <libsystem/io/Stream.h>
+#include <libsystem/system/System.h>
+#include <libwidget/Widgets.h>
+
+#include "benchmark/Benchmarks.h"
+
+#define LAYOUT_ROW_COUNT 128
+#define LAYOUT_COLUMN_COUNT 16
+#define LAYOUT_FRAME_COUNT 64
+
+void layout_benchmark()
+{
+    // Detached from any window, about as many widgets as a busy widget-factory.
+    auto root = new Container(nullptr);
+    root->layout(VFLOW(4));
+
+    Label *last_label = nullptr;
+
+    for (int row = 0; row < LAYOUT_ROW_COUNT; row++)
+    {
+        auto container = new Container(root);
+        container->layout(HFLOW(4));
+
+        for (int column = 0; column < LAYOUT_COLUMN_COUNT; column++)
+        {
+            last_label = new Label(container, "Hello, world!");
+
+            if (column % 4 == 0)
+            {
+                last_label->attributes(LAYOUT_FILL);
+            }
+        }
+    }
+
+    uint start = system_get_ticks();
+
+    root->bound(Rectangle(1920, 1080));
+    root->relayout();
+
+    uint first = system_get_ticks() - start;
+
+    start = system_get_ticks();
+
+    for (int frame = 0; frame < LAYOUT_FRAME_COUNT; frame++)
+    {
+        last_label->text(frame % 2 ? "Hello, world!" : "Goodbye, world!");
+        root->relayout();
+    }
+
+    uint incremental = system_get_ticks() - start;
+
+    start = system_get_ticks();
+
+    for (int frame = 0; frame < LAYOUT_FRAME_COUNT; frame++)
+    {
+        root->bound(Rectangle(1920 - frame % 2, 1080));
+        root->relayout();
+    }
+
+    uint resized = system_get_ticks() - start;
+
+    printf("    %d widgets\n", LAYOUT_ROW_COUNT * (LAYOUT_COLUMN_COUNT + 1) + 1);
+    printf("    first layout: %dms\n", first);
+    printf("    one label changed: %dms/frame\n", incremental / LAYOUT_FRAME_COUNT);
+    printf("    resized: %dms/frame\n", resized / LAYOUT_FRAME_COUNT);
+
+    delete root;
+}
@@ -0,0 +1,76 @@
+#include <libgraphic/Painter.h>
+#include <libsystem/io/Stream.h>
+#include <libsystem/system/System.h>
+#include <libwidget/widgets/Table.h>
+
+#include "benchmark/Benchmarks.h"
+
+#define TABLE_ROW_COUNT 100000
+#define TABLE_COLUMN_COUNT 4
+#define TABLE_FRAME_COUNT 128
+
+class SyntheticModel : public TableModel
+{
+private:
+    int _fetched = 0;
+
+public:
+    int fetched() { return _fetched; }
+
+    int rows() override { return TABLE_ROW_COUNT; }
+
+    int columns() override { return TABLE_COLUMN_COUNT; }
+
+    String header(int column) override
+    {
+        __unused(column);
+
+        return "Column";
+    }
+
+    Variant data(int row, int column) override
+    {
+        _fetched++;
+
+        return Variant("Row %d, column %d", row, column);
+    }
+};
+
+static void table_benchmark_scroll(Table &table, SyntheticModel &model, Painter &painter, const char *name, int step)
+{
+    int fetched = model.fetched();
+    uint start = system_get_ticks();
+
+    for (int frame = 0; frame < TABLE_FRAME_COUNT; frame++)
+    {
+        table.scroll_to((TABLE_ROW_COUNT / 2 + frame * step) % TABLE_ROW_COUNT);
+        table.paint(painter, table.bound());
+    }
+
+    uint elapsed = system_get_ticks() - start;
+
+    printf("    %s: %dms/frame, %d cells fetched/frame\n", name, elapsed / TABLE_FRAME_COUNT, (model.fetched() - fetched) / TABLE_FRAME_COUNT);
+}
+
+void table_benchmark()
+{
+    auto screen = Bitmap::create_shared(800, 600).take_value();
+    Painter painter{screen};
+
+    auto model = make<SyntheticModel>();
+
+    // The table isn't attached to a window, so it can't pick its colors from the theme.
+    auto table = new Table(nullptr, model);
+    table->color(THEME_FOREGROUND, Colors::WHITE);
+    table->color(THEME_BACKGROUND, Colors::BLACK);
+    table->color(THEME_SELECTION, Colors::BLUE);
+    table->color(THEME_BORDER, Colors::GRAY);
+
+    table->bound(screen->bound());
+    table->relayout();
+
+    table_benchmark_scroll(*table, *model, painter, "scroll by row", 1);
+    table_benchmark_scroll(*table, *model, painter, "jump around", 7919);
+
+    delete table;
+}
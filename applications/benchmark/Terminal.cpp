@@ -0,0 +1,49 @@
+#include <libsystem/core/CString.h>
+#include <libsystem/io/Stream.h>
+#include <libsystem/math/MinMax.h>
+#include <libsystem/system/System.h>
+#include <libterminal/Terminal.h>
+
+#include "benchmark/Benchmarks.h"
+
+#define TERMINAL_LINE_COUNT 65536
+#define TERMINAL_CHUNK_SIZE 4096
+
+void terminal_benchmark()
+{
+    // Something that looks like the output of a build: mostly plain text,
+    // a few colors, and lines of varying lengths.
+    size_t size = 0;
+    char *buffer = (char *)malloc(TERMINAL_LINE_COUNT * 128);
+
+    for (int i = 0; i < TERMINAL_LINE_COUNT; i++)
+    {
+        if (i % 8 == 0)
+        {
+            size += snprintf(buffer + size, 128, "\e[32m[%5d/%5d]\e[0m Compiling libraries/libsomething/Something%d.cpp\n", i, TERMINAL_LINE_COUNT, i);
+        }
+        else
+        {
+            size += snprintf(buffer + size, 128, "    %d: the quick brown fox jumps over the lazy dog %d times\n", i, i % 97);
+        }
+    }
+
+    auto terminal = own<terminal::Terminal>(80, 24);
+
+    uint start = system_get_ticks();
+
+    for (size_t offset = 0; offset < size; offset += TERMINAL_CHUNK_SIZE)
+    {
+        terminal->write(buffer + offset, MIN(TERMINAL_CHUNK_SIZE, size - offset));
+    }
+
+    uint elapsed = MAX(system_get_ticks() - start, 1u);
+
+    size_t kib_per_second = size / 1024 * 1000 / elapsed;
+
+    printf("    %dKiB in %dms\n", (int)(size / 1024), elapsed);
+    printf("    throughput: %d.%02dMiB/s\n", (int)(kib_per_second / 1024), (int)(kib_per_second % 1024 * 100 / 1024));
+    printf("    scrollback: %d lines\n", terminal->scrollback().count());
+
+    free(buffer);
+}
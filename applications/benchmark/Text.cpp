@@ -0,0 +1,135 @@
+#include <libgraphic/Painter.h>
+#include <libsystem/io/Stream.h>
+#include <libsystem/system/System.h>
+
+#include "benchmark/Benchmarks.h"
+
+#define TEXT_TERMINAL_WIDTH 80
+#define TEXT_TERMINAL_HEIGHT 24
+#define TEXT_EDITOR_LINES 48
+#define TEXT_FRAME_COUNT 16
+
+static const char *_text_editor_line = "    for (int i = 0; i < count; i++) { total += values[i] * 2; }";
+
+static void text_report(const char *workload, size_t glyphs, uint elapsed)
+{
+    printf("    %s: %d glyphs in %dms, %d glyphs/s\n",
+           workload,
+           glyphs,
+           elapsed,
+           glyphs * 1000 / MAX(elapsed, 1));
+}
+
+static void text_benchmark_terminal(Painter &painter, Font &font)
+{
+    Color color = Colors::WHITE;
+    size_t glyphs = 0;
+
+    uint start = system_get_ticks();
+
+    for (int frame = 0; frame < TEXT_FRAME_COUNT; frame++)
+    {
+        for (int y = 0; y < TEXT_TERMINAL_HEIGHT; y++)
+        {
+            for (int x = 0; x < TEXT_TERMINAL_WIDTH; x++)
+            {
+                Codepoint codepoint = U'!' + (x + y * TEXT_TERMINAL_WIDTH + frame) % 94;
+
+                Glyph &glyph = font.glyph(codepoint);
+                painter.draw_glyph(font, glyph, Vec2i(x * 7, y * 16 + 12), color);
+
+                glyphs++;
+            }
+        }
+    }
+
+    text_report("terminal", glyphs, system_get_ticks() - start);
+}
+
+static void text_benchmark_terminal_strings(Painter &painter, Font &font)
+{
+    Color color = Colors::WHITE;
+    size_t glyphs = 0;
+
+    char lines[TEXT_TERMINAL_HEIGHT][TEXT_TERMINAL_WIDTH + 1];
+
+    for (int y = 0; y < TEXT_TERMINAL_HEIGHT; y++)
+    {
+        for (int x = 0; x < TEXT_TERMINAL_WIDTH; x++)
+        {
+            lines[y][x] = '!' + (x + y * TEXT_TERMINAL_WIDTH) % 94;
+        }
+
+        lines[y][TEXT_TERMINAL_WIDTH] = '\0';
+    }
+
+    uint start = system_get_ticks();
+
+    for (int frame = 0; frame < TEXT_FRAME_COUNT; frame++)
+    {
+        for (int y = 0; y < TEXT_TERMINAL_HEIGHT; y++)
+        {
+            painter.draw_string(font, lines[y], Vec2i(0, y * 16 + 12), color);
+            glyphs += TEXT_TERMINAL_WIDTH;
+        }
+    }
+
+    text_report("terminal strings", glyphs, system_get_ticks() - start);
+}
+
+static void text_benchmark_editor(Painter &painter, Font &font)
+{
+    Color color = Colors::WHITE;
+    size_t glyphs = 0;
+
+    uint start = system_get_ticks();
+
+    for (int frame = 0; frame < TEXT_FRAME_COUNT; frame++)
+    {
+        for (int line = 0; line < TEXT_EDITOR_LINES; line++)
+        {
+            painter.draw_string(font, _text_editor_line, Vec2i(0, line * 16 + 12), color);
+            glyphs += strlen(_text_editor_line);
+        }
+    }
+
+    text_report("text editor", glyphs, system_get_ticks() - start);
+}
+
+static void text_benchmark_truetype(Painter &painter)
+{
+    TrueTypeFamily *family = truetype_family_create("/Files/Fonts/Roboto/Roboto-Medium.ttf");
+    TrueTypeFont *font = truetypefont_create(family, 14);
+
+    Color color = Colors::WHITE;
+    size_t glyphs = 0;
+
+    uint start = system_get_ticks();
+
+    for (int frame = 0; frame < TEXT_FRAME_COUNT; frame++)
+    {
+        for (int line = 0; line < TEXT_EDITOR_LINES; line++)
+        {
+            painter.draw_truetype_string(font, _text_editor_line, Vec2i(0, line * 16 + 12), color);
+            glyphs += strlen(_text_editor_line);
+        }
+    }
+
+    text_report("truetype", glyphs, system_get_ticks() - start);
+
+    truetypefont_destroy(font);
+    truetype_family_destroy(family);
+}
+
+void text_benchmark()
+{
+    auto bitmap = Bitmap::create_shared(TEXT_TERMINAL_WIDTH * 7, TEXT_EDITOR_LINES * 16).take_value();
+    Painter painter{bitmap};
+
+    auto font = Font::create("mono").take_value();
+
+    text_benchmark_terminal(painter, *font);
+    text_benchmark_terminal_strings(painter, *font);
+    text_benchmark_editor(painter, *font);
+    text_benchmark_truetype(painter);
+}
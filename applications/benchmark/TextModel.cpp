@@ -0,0 +1,76 @@
+#include <libsystem/io/Stream.h>
+#include <libsystem/system/System.h>
+#include <libwidget/model/TextModel.h>
+
+#include "benchmark/Benchmarks.h"
+
+#define TEXT_MODEL_LINE_COUNT 65536
+#define TEXT_MODEL_LINE_LENGTH 64
+#define TEXT_MODEL_EDIT_COUNT 256
+#define TEXT_MODEL_VISIBLE_LINES 64
+
+void text_model_benchmark()
+{
+    // About 4MiB of text, as if read from the disk.
+    size_t size = TEXT_MODEL_LINE_COUNT * TEXT_MODEL_LINE_LENGTH;
+    char *buffer = (char *)malloc(size);
+
+    for (size_t i = 0; i < size; i++)
+    {
+        buffer[i] = (i + 1) % TEXT_MODEL_LINE_LENGTH == 0 ? '\n' : 'a' + i % 26;
+    }
+
+    uint start = system_get_ticks();
+
+    auto model = make<TextModel>(Vector(ADOPT, buffer, size));
+
+    uint load = system_get_ticks() - start;
+
+    TextCursor cursor;
+    cursor.move_to_within(*model, TEXT_MODEL_LINE_COUNT / 2);
+    cursor.move_to_within(model->line(cursor.line()), TEXT_MODEL_LINE_LENGTH / 2);
+
+    start = system_get_ticks();
+
+    for (int i = 0; i < TEXT_MODEL_EDIT_COUNT; i++)
+    {
+        model->append_at(cursor, U'é');
+    }
+
+    uint typing = system_get_ticks() - start;
+
+    start = system_get_ticks();
+
+    for (int i = 0; i < TEXT_MODEL_EDIT_COUNT; i++)
+    {
+        model->newline_at(cursor);
+        model->backspace_at(cursor);
+    }
+
+    uint newline = system_get_ticks() - start;
+
+    start = system_get_ticks();
+
+    for (int i = 0; i < TEXT_MODEL_EDIT_COUNT; i++)
+    {
+        model->backspace_at(cursor);
+    }
+
+    uint backspace = system_get_ticks() - start;
+
+    start = system_get_ticks();
+
+    for (size_t i = 0; i < TEXT_MODEL_VISIBLE_LINES; i++)
+    {
+        model->line(cursor.line() + i);
+    }
+
+    uint screen = system_get_ticks() - start;
+
+    printf("    %d lines, %dKiB\n", (int)model->line_count(), (int)(model->size() / 1024));
+    printf("    load: %dms\n", load);
+    printf("    typing: %dms/%d characters\n", typing, TEXT_MODEL_EDIT_COUNT);
+    printf("    newline and backspace: %dms/%d times\n", newline, TEXT_MODEL_EDIT_COUNT);
+    printf("    backspace: %dms/%d characters\n", backspace, TEXT_MODEL_EDIT_COUNT);
+    printf("    one screen of lines: %dms\n", screen);
+}
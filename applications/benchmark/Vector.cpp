@@ -0,0 +1,69 @@
+#include <libgraphic/Painter.h>
+#include <libgraphic/vector/Rasterizer.h>
+#include <libsystem/io/Stream.h>
+#include <libsystem/system/System.h>
+
+#include "benchmark/Benchmarks.h"
+
+#define VECTOR_ICON_VIEWBOX 24
+#define VECTOR_ITERATIONS 64
+
+// A few paths from /icons, from a single shape up to the cog's many curves.
+static const char *_vector_icons[] = {
+    "M12,4A4,4 0 0,1 16,8A4,4 0 0,1 12,12A4,4 0 0,1 8,8A4,4 0 0,1 12,4M12,14C16.42,14 20,15.79 20,18V20H4V18C4,15.79 7.58,14 12,14Z",
+    "M13 14H11V9H13M13 18H11V16H13M1 21H23L12 2L1 21Z",
+    "M10,4H4C2.89,4 2,4.89 2,6V18A2,2 0 0,0 4,20H20A2,2 0 0,0 22,18V8C22,6.89 21.1,6 20,6H12L10,4Z",
+    "M10,20V14H14V20H19V12H22L12,3L2,12H5V20H10Z",
+    "M12,15.5A3.5,3.5 0 0,1 8.5,12A3.5,3.5 0 0,1 12,8.5A3.5,3.5 0 0,1 15.5,12A3.5,3.5 0 0,1 12,15.5M19.43,12.97C19.47,12.65 19.5,12.33 19.5,12C19.5,11.67 19.47,11.34 19.43,11L21.54,9.37C21.73,9.22 21.78,8.95 21.66,8.73L19.66,5.27C19.54,5.05 19.27,4.96 19.05,5.05L16.56,6.05C16.04,5.66 15.5,5.32 14.87,5.07L14.5,2.42C14.46,2.18 14.25,2 14,2H10C9.75,2 9.54,2.18 9.5,2.42L9.13,5.07C8.5,5.32 7.96,5.66 7.44,6.05L4.95,5.05C4.73,4.96 4.46,5.05 4.34,5.27L2.34,8.73C2.21,8.95 2.27,9.22 2.46,9.37L4.57,11C4.53,11.34 4.5,11.67 4.5,12C4.5,12.33 4.53,12.65 4.57,12.97L2.46,14.63C2.27,14.78 2.21,15.05 2.34,15.27L4.34,18.73C4.46,18.95 4.73,19.03 4.95,18.95L7.44,17.94C7.96,18.34 8.5,18.68 9.13,18.93L9.5,21.58C9.54,21.82 9.75,22 10,22H14C14.25,22 14.46,21.82 14.5,21.58L14.87,18.93C15.5,18.67 16.04,18.34 16.56,17.94L19.05,18.95C19.27,19.03 19.54,18.95 19.66,18.73L21.66,15.27C21.78,15.05 21.73,14.78 21.54,14.63L19.43,12.97Z",
+};
+
+static const int _vector_sizes[] = {18, 24, 36, 48, 128};
+
+static void vector_benchmark_size(Painter &painter, Vector<graphic::Path> &paths, int size, graphic::FillRule rule)
+{
+    graphic::Rasterizer rasterizer{};
+    auto transform = Trans2f::scale(size / (float)VECTOR_ICON_VIEWBOX);
+
+    size_t icons = 0;
+
+    uint start = system_get_ticks();
+
+    for (int iteration = 0; iteration < VECTOR_ITERATIONS; iteration++)
+    {
+        for (size_t i = 0; i < paths.count(); i++)
+        {
+            painter.clear_rectangle(Rectangle(size, size), Colors::BLACK);
+            rasterizer.fill(painter, paths[i], {0, 0}, transform, Colors::WHITE, rule);
+            icons++;
+        }
+    }
+
+    uint elapsed = system_get_ticks() - start;
+
+    printf("    %dpx %s: %d icons in %dms, %d icons/s\n",
+           size,
+           rule == graphic::FillRule::NONZERO ? "non-zero" : "even-odd",
+           icons,
+           elapsed,
+           icons * 1000 / MAX(elapsed, 1));
+}
+
+void vector_benchmark()
+{
+    auto bitmap = Bitmap::create_shared(128, 128).take_value();
+    Painter painter{bitmap};
+
+    Vector<graphic::Path> paths;
+
+    for (size_t i = 0; i < __array_length(_vector_icons); i++)
+    {
+        paths.push_back(graphic::Path::parse(_vector_icons[i]));
+    }
+
+    for (size_t i = 0; i < __array_length(_vector_sizes); i++)
+    {
+        vector_benchmark_size(painter, paths, _vector_sizes[i], graphic::FillRule::NONZERO);
+    }
+
+    vector_benchmark_size(painter, paths, 24, graphic::FillRule::EVENODD);
+}
@@ -0,0 +1,42 @@
+#include <libgraphic/Painter.h>
+#include <libsystem/io/Stream.h>
+#include <libsystem/system/System.h>
+
+#include "benchmark/Benchmarks.h"
+
+#define WALLPAPER_SCREEN_WIDTH 1920
+#define WALLPAPER_SCREEN_HEIGHT 1080
+#define WALLPAPER_FRAME_COUNT 8
+
+void wallpaper_benchmark()
+{
+    auto screen = Bitmap::create_shared(WALLPAPER_SCREEN_WIDTH, WALLPAPER_SCREEN_HEIGHT).take_value();
+    auto wallpaper = Bitmap::load_from_or_placeholder("/Files/Wallpapers/mountains.png");
+    wallpaper->filtering(BITMAP_FILTERING_LINEAR);
+
+    Painter painter{screen};
+
+    uint start = system_get_ticks();
+
+    for (int frame = 0; frame < WALLPAPER_FRAME_COUNT; frame++)
+    {
+        painter.blit_bitmap_no_alpha(*wallpaper, wallpaper->bound(), screen->bound());
+    }
+
+    uint resampled = system_get_ticks() - start;
+
+    auto scaled_wallpaper = Bitmap::create_shared(WALLPAPER_SCREEN_WIDTH, WALLPAPER_SCREEN_HEIGHT).take_value();
+    Painter{scaled_wallpaper}.blit_bitmap_no_alpha(*wallpaper, wallpaper->bound(), scaled_wallpaper->bound());
+
+    start = system_get_ticks();
+
+    for (int frame = 0; frame < WALLPAPER_FRAME_COUNT; frame++)
+    {
+        painter.blit_bitmap_no_alpha(*scaled_wallpaper, screen->bound(), screen->bound());
+    }
+
+    uint cached = system_get_ticks() - start;
+
+    printf("    resampled: %dms/frame\n", resampled / WALLPAPER_FRAME_COUNT);
+    printf("    cached: %dms/frame\n", cached / WALLPAPER_FRAME_COUNT);
+}
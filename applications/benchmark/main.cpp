@@ -0,0 +1,52 @@
+#include <libsystem/core/CString.h>
+#include <libsystem/io/Stream.h>
+#include <libsystem/process/Process.h>
+
+#include "benchmark/Benchmarks.h"
+
+static Benchmark _benchmarks[] = {
+    {"compositing", compositing_benchmark},
+    {"wallpaper", wallpaper_benchmark},
+    {"text", text_benchmark},
+    {"fonts", fonts_benchmark},
+    {"vector", vector_benchmark},
+    {"assets", assets_benchmark},
+    {"blur", blur_benchmark},
+    {"layout", layout_benchmark},
+    {"table", table_benchmark},
+    {"text-model", text_model_benchmark},
+    {"terminal", terminal_benchmark},
+    {nullptr, nullptr},
+};
+
+static bool should_run(int argc, char **argv, const char *name)
+{
+    if (argc == 1)
+    {
+        return true;
+    }
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], name) == 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+int main(int argc, char **argv)
+{
+    for (size_t i = 0; _benchmarks[i].name; i++)
+    {
+        if (should_run(argc, argv, _benchmarks[i].name))
+        {
+            printf("\e[1m%s\e[0m\n", _benchmarks[i].name);
+            _benchmarks[i].callback();
+        }
+    }
+
+    return PROCESS_SUCCESS;
+}
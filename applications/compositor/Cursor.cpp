@@ -77,8 +77,8 @@ void cursor_handle_packet(MousePacket packet)
 
     if (_mouse_old_position != _mouse_position)
     {
-        renderer_region_dirty(cursor_dirty_bound_from_position(_mouse_old_position));
-        renderer_region_dirty(cursor_dirty_bound_from_position(_mouse_position));
+        renderer_cursor_dirty(cursor_dirty_bound_from_position(_mouse_old_position));
+        renderer_cursor_dirty(cursor_dirty_bound_from_position(_mouse_position));
 
         if (window_on_focus)
             window_on_focus->handle_mouse_move(_mouse_old_position, _mouse_position, _mouse_buttons);
@@ -33,6 +33,7 @@ enum CompositorMessageType
 #define WINDOW_SWALLOW (1 << 3)
 #define WINDOW_TRANSPARENT (1 << 4)
 #define WINDOW_NO_FOCUS (1 << 5)
+#define WINDOW_ACRYLIC (1 << 6)
 
 typedef unsigned int WindowFlag;
 
@@ -1,4 +1,5 @@
 #include <libgraphic/Framebuffer.h>
+#include <libsystem/thread/WorkerPool.h>
 #include <libutils/Vector.h>
 
 #include "compositor/Cursor.h"
@@ -6,20 +7,60 @@
 #include "compositor/Renderer.h"
 #include "compositor/Window.h"
 
+#define RENDERER_TILE_SIZE 64
+
+#define RENDERER_BACKDROP_BLUR_RADIUS 48
+
+// Only one processor is used by hjert for now, bump this once it can run
+// workers on the others.
+#define RENDERER_WORKER_COUNT 1
+
 static OwnPtr<Framebuffer> _framebuffer;
 static RefPtr<Bitmap> _wallpaper;
+static RefPtr<Bitmap> _scaled_wallpaper;
 
 static Vector<Rectangle> _dirty_regions;
 
+static OwnPtr<WorkerPool> _workers;
+static Vector<Painter> _workers_painters;
+static Vector<Rectangle> _tiles;
+
+static void renderer_setup_workers_painters()
+{
+    _workers_painters.clear();
+
+    for (size_t i = 0; i < _workers->worker_count(); i++)
+    {
+        _workers_painters.push_back(Painter(_framebuffer->bitmap()));
+    }
+}
+
+static void renderer_scale_wallpaper()
+{
+    // Resampling the wallpaper is expensive, do it once per resolution or
+    // wallpaper change instead of for every repaint.
+    _scaled_wallpaper = Bitmap::create_shared(
+                            renderer_bound().width(),
+                            renderer_bound().height())
+                            .take_value();
+
+    Painter painter{_scaled_wallpaper};
+    painter.blit_bitmap_no_alpha(*_wallpaper, _wallpaper->bound(), _scaled_wallpaper->bound());
+}
+
 void renderer_initialize()
 {
     _framebuffer = Framebuffer::open().take_value();
     _wallpaper = Bitmap::load_from_or_placeholder("/Files/Wallpapers/mountains.png");
+    renderer_scale_wallpaper();
+
+    _workers = own<WorkerPool>(RENDERER_WORKER_COUNT);
+    renderer_setup_workers_painters();
 
     renderer_region_dirty(_framebuffer->resolution());
 }
 
-void renderer_region_dirty(Rectangle new_region)
+static void renderer_add_dirty_region(Rectangle new_region)
 {
     if (new_region.is_empty())
     {
@@ -38,10 +79,10 @@ void renderer_region_dirty(Rectangle new_region)
 
             new_region.substract(region, top, botton, left, right);
 
-            renderer_region_dirty(top);
-            renderer_region_dirty(botton);
-            renderer_region_dirty(left);
-            renderer_region_dirty(right);
+            renderer_add_dirty_region(top);
+            renderer_add_dirty_region(botton);
+            renderer_add_dirty_region(left);
+            renderer_add_dirty_region(right);
 
             merged = true;
 
@@ -59,24 +100,53 @@ void renderer_region_dirty(Rectangle new_region)
     }
 }
 
-void renderer_composite_wallpaper(Rectangle region)
+static void renderer_backdrops_dirty(Rectangle region, Window *below)
 {
-    double scale_x = _wallpaper->width() / (double)_framebuffer->resolution().width();
-    double scale_y = _wallpaper->height() / (double)_framebuffer->resolution().height();
+    bool is_above = below == nullptr;
 
-    Rectangle source(
-        region.x() * scale_x,
-        region.y() * scale_y,
-        region.width() * scale_x,
-        region.height() * scale_y);
+    manager_iterate_back_to_front([&](Window *window) {
+        if (window == below)
+        {
+            is_above = true;
+        }
+        else if (is_above &&
+                 (window->flags() & WINDOW_ACRYLIC) &&
+                 window->bound().colide_with(region))
+        {
+            // The blur spreads the change over the whole window.
+            window->backdrop_dirty(true);
+            renderer_add_dirty_region(window->bound());
+        }
 
-    _framebuffer->painter().blit_bitmap_no_alpha(*_wallpaper, source, region);
-    _framebuffer->mark_dirty(region);
+        return Iteration::CONTINUE;
+    });
 }
 
-void renderer_composite_region(Rectangle region, Window *window_transparent)
+void renderer_region_dirty(Rectangle region)
 {
-    renderer_composite_wallpaper(region);
+    renderer_backdrops_dirty(region, nullptr);
+    renderer_add_dirty_region(region);
+}
+
+void renderer_window_dirty(Window *window, Rectangle region)
+{
+    renderer_backdrops_dirty(region, window);
+    renderer_add_dirty_region(region);
+}
+
+void renderer_cursor_dirty(Rectangle region)
+{
+    renderer_add_dirty_region(region);
+}
+
+void renderer_composite_wallpaper(Painter &painter, Rectangle region)
+{
+    painter.blit_bitmap_no_alpha(*_scaled_wallpaper, region, region);
+}
+
+void renderer_composite_region(Painter &painter, Rectangle region, Window *window_transparent)
+{
+    renderer_composite_wallpaper(painter, region);
 
     manager_iterate_back_to_front([&](Window *window) {
         if (window == window_transparent)
@@ -92,16 +162,47 @@ void renderer_composite_region(Rectangle region, Window *window_transparent)
                 destination.position() - window->bound().position(),
                 destination.size());
 
-            _framebuffer->painter().blit_bitmap(window->frontbuffer(), source, destination);
+            painter.blit_bitmap(window->frontbuffer(), source, destination);
         }
 
         return Iteration::CONTINUE;
     });
+}
+
+static void renderer_update_backdrop(Window *window)
+{
+    Rectangle bound = window->bound().clipped_with(renderer_bound());
 
-    _framebuffer->mark_dirty(region);
+    if (bound.is_empty())
+    {
+        return;
+    }
+
+    if (!window->backdrop() || window->backdrop()->size() != bound.size())
+    {
+        auto backdrop_or_error = Bitmap::create_shared(bound.width(), bound.height());
+
+        if (!backdrop_or_error.success())
+        {
+            window->backdrop(nullptr);
+            return;
+        }
+
+        window->backdrop(backdrop_or_error.take_value());
+    }
+
+    // The whole backdrop is blurred at once, blurring tile by tile would
+    // leave seams where the tiles meet.
+    Painter painter{window->backdrop()};
+    painter.transform(-bound.position());
+
+    renderer_composite_region(painter, bound, window);
+    painter.blur_rectangle(bound, RENDERER_BACKDROP_BLUR_RADIUS);
+
+    window->backdrop_dirty(false);
 }
 
-void renderer_region(Rectangle region)
+void renderer_region(Painter &painter, Rectangle region)
 {
     bool should_paint_wallpaper = true;
 
@@ -119,19 +220,25 @@ void renderer_region(Rectangle region)
                 destination.position() - window->bound().position(),
                 destination.size());
 
-            if (window->flags() & WINDOW_TRANSPARENT)
+            if ((window->flags() & WINDOW_ACRYLIC) && window->backdrop())
+            {
+                Rectangle backdrop_source(
+                    destination.position() - window->bound().clipped_with(renderer_bound()).position(),
+                    destination.size());
+
+                painter.blit_bitmap_no_alpha(*window->backdrop(), backdrop_source, destination);
+                painter.blit_bitmap(window->frontbuffer(), source, destination);
+            }
+            else if (window->flags() & WINDOW_TRANSPARENT)
             {
-                renderer_composite_region(destination, window);
-                //_framebuffer->painter().blur_rectangle(destination, 48);
-                _framebuffer->painter().blit_bitmap(window->frontbuffer(), source, destination);
+                renderer_composite_region(painter, destination, window);
+                painter.blit_bitmap(window->frontbuffer(), source, destination);
             }
             else
             {
-                _framebuffer->painter().blit_bitmap_no_alpha(window->frontbuffer(), source, destination);
+                painter.blit_bitmap_no_alpha(window->frontbuffer(), source, destination);
             }
 
-            _framebuffer->mark_dirty(destination);
-
             Rectangle top;
             Rectangle botton;
             Rectangle left;
@@ -139,10 +246,10 @@ void renderer_region(Rectangle region)
 
             region.substract(destination, top, botton, left, right);
 
-            renderer_region(top);
-            renderer_region(botton);
-            renderer_region(left);
-            renderer_region(right);
+            renderer_region(painter, top);
+            renderer_region(painter, botton);
+            renderer_region(painter, left);
+            renderer_region(painter, right);
 
             should_paint_wallpaper = false;
 
@@ -154,7 +261,7 @@ void renderer_region(Rectangle region)
 
     if (should_paint_wallpaper)
     {
-        renderer_composite_wallpaper(region);
+        renderer_composite_wallpaper(painter, region);
     }
 }
 
@@ -163,14 +270,69 @@ Rectangle renderer_bound()
     return _framebuffer->resolution();
 }
 
+static void renderer_split_in_tiles(Rectangle region)
+{
+    if (region.is_empty())
+    {
+        return;
+    }
+
+    // Dirty regions never overlap and tiles are clipped to their region,
+    // so tiles can be composited in any order and by any worker.
+    int first_column = region.left() / RENDERER_TILE_SIZE;
+    int last_column = (region.right() - 1) / RENDERER_TILE_SIZE;
+    int first_row = region.top() / RENDERER_TILE_SIZE;
+    int last_row = (region.bottom() - 1) / RENDERER_TILE_SIZE;
+
+    for (int row = first_row; row <= last_row; row++)
+    {
+        for (int column = first_column; column <= last_column; column++)
+        {
+            Rectangle tile(
+                column * RENDERER_TILE_SIZE,
+                row * RENDERER_TILE_SIZE,
+                RENDERER_TILE_SIZE,
+                RENDERER_TILE_SIZE);
+
+            _tiles.push_back(tile.clipped_with(region));
+        }
+    }
+}
+
 void renderer_repaint_dirty()
 {
+    manager_iterate_back_to_front([](Window *window) {
+        if ((window->flags() & WINDOW_ACRYLIC) && window->backdrop_dirty())
+        {
+            renderer_update_backdrop(window);
+        }
+
+        return Iteration::CONTINUE;
+    });
+
+    _dirty_regions.foreach ([](Rectangle region) {
+        renderer_split_in_tiles(region.clipped_with(renderer_bound()));
+        return Iteration::CONTINUE;
+    });
+
+    _workers->run(_tiles.count(), [](size_t index, size_t worker) {
+        Painter &painter = _workers_painters[worker];
+
+        painter.push();
+        painter.clip(_tiles[index]);
+        renderer_region(painter, _tiles[index]);
+        painter.pop();
+    });
+
+    _tiles.clear();
+
     _dirty_regions.foreach ([](Rectangle region) {
-        renderer_region(region);
+        _framebuffer->mark_dirty(region);
 
         if (region.colide_with(cursor_bound()))
         {
-            renderer_region(cursor_bound());
+            renderer_region(_framebuffer->painter(), cursor_bound());
+            _framebuffer->mark_dirty(cursor_bound());
 
             cursor_render(_framebuffer->painter());
         }
@@ -186,6 +348,8 @@ void renderer_repaint_dirty()
 bool renderer_set_resolution(int width, int height)
 {
     auto result = _framebuffer->set_resolution(Vec2i(width, height));
+    renderer_scale_wallpaper();
+    renderer_setup_workers_painters();
     renderer_region_dirty(renderer_bound());
     return result == SUCCESS;
 }
@@ -194,6 +358,7 @@ void renderer_set_wallaper(RefPtr<Bitmap> wallaper)
 {
     _wallpaper = wallaper;
     _wallpaper->filtering(BITMAP_FILTERING_LINEAR);
+    renderer_scale_wallpaper();
 
     renderer_region_dirty(renderer_bound());
 }
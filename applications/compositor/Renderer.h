@@ -3,12 +3,20 @@
 #include <libgraphic/Bitmap.h>
 #include <libsystem/algebra/Rect.h>
 
+struct Window;
+
 void renderer_initialize();
 
 Rectangle renderer_bound();
 
 void renderer_region_dirty(Rectangle region);
 
+// Only the content of window changed, so the backdrops of the windows below it are still good.
+void renderer_window_dirty(struct Window *window, Rectangle region);
+
+// Nothing changed but the cursor, which is never part of a backdrop.
+void renderer_cursor_dirty(Rectangle region);
+
 void renderer_repaint_dirty();
 
 bool renderer_set_resolution(int width, int height);
@@ -215,5 +215,5 @@ void Window::flip_buffers(int frontbuffer_handle, Vec2i frontbuffer_size, int ba
         _backbuffer = new_backbuffer.take_value();
     }
 
-    renderer_region_dirty(region.offset(bound().position()));
+    renderer_window_dirty(this, region.offset(bound().position()));
 }
@@ -23,6 +23,9 @@ private:
     RefPtr<Bitmap> _frontbuffer;
     RefPtr<Bitmap> _backbuffer;
 
+    RefPtr<Bitmap> _backdrop;
+    bool _backdrop_dirty = true;
+
 public:
     int id() { return _id; }
     WindowFlag flags() { return _flags; };
@@ -40,6 +43,16 @@ public:
         return *_frontbuffer;
     }
 
+    // What is behind an acrylic window, already blurred. It is only
+    // rendered again when something below the window changes.
+    RefPtr<Bitmap> backdrop() { return _backdrop; }
+
+    void backdrop(RefPtr<Bitmap> backdrop) { _backdrop = backdrop; }
+
+    bool backdrop_dirty() { return _backdrop_dirty; }
+
+    void backdrop_dirty(bool backdrop_dirty) { _backdrop_dirty = backdrop_dirty; }
+
     Window(
         int id,
         WindowFlag flags,
@@ -1,5 +1,6 @@
 #include <abi/Paths.h>
 
+#include <libgraphic/Font.h>
 #include <libsystem/Assert.h>
 #include <libsystem/Logger.h>
 #include <libsystem/eventloop/EventLoop.h>
@@ -163,6 +164,11 @@ int main(int argc, char const *argv[])
     cursor_initialize();
     renderer_initialize();
 
+    // Populate the session font cache before any client starts, the
+    // compositor keeps the shared copies alive for the whole session.
+    Font::create("mono");
+    Font::create("sans");
+
     process_run("panel", nullptr);
     process_run("terminal", nullptr);
 
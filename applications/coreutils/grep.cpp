@@ -1,106 +1,107 @@
 #include <libsystem/core/CString.h>
 #include <libsystem/io/Stream.h>
+#include <libsystem/regex/Regex.h>
 
-int matchstar(int c, char *re, char *text);
+#define GREP_BUFFER_SIZE (64 * 1024)
 
-// matchhere: search for re at beginning of text
-int matchhere(char *re, char *text)
+static void grep_line(Regex &regex, const char *line, size_t length)
 {
-    if (re[0] == '\0')
+    if (regex.match(line, length))
     {
-        return 1;
+        stream_write(out_stream, line, length);
+        stream_write(out_stream, "\n", 1);
     }
-
-    if (re[1] == '*')
-    {
-        return matchstar(re[0], re + 2, text);
-    }
-
-    if (re[0] == '$' && re[1] == '\0')
-    {
-        return *text == '\0';
-    }
-
-    if (*text != '\0' && (re[0] == '.' || re[0] == *text))
-    {
-        return matchhere(re + 1, text + 1);
-    }
-
-    return 0;
 }
 
-// matchstar: search for c*re at beginning of text
-int matchstar(int c, char *re, char *text)
+// Every line of the buffer ends with a '\n'.
+static void grep_lines(Regex &regex, const char *lines, size_t size)
 {
-    do
+    const char *current = lines;
+    const char *end = lines + size;
+
+    while (current < end)
     {
-        // a * matches zero or more instances
-        if (matchhere(re, text))
-            return 1;
-    } while (*text != '\0' && (*text++ == c || c == '.'));
+        if (!regex.anchored())
+        {
+            // Lines without the literal part of the pattern are skipped without looking at them.
+            const char *candidate = regex.candidate(current, end - current);
 
-    return 0;
-}
+            if (!candidate)
+            {
+                return;
+            }
 
-int match(char *re, char *text)
-{
-    if (re[0] == '^')
-    {
-        return matchhere(re + 1, text);
-    }
+            while (candidate > current && candidate[-1] != '\n')
+            {
+                candidate--;
+            }
 
-    do
-    {
-        // must look at empty string
-        if (matchhere(re, text))
-        {
-            return 1;
+            current = candidate;
         }
-    } while (*text++ != '\0');
 
-    return 0;
+        const char *newline = (const char *)memchr(current, '\n', end - current);
+
+        grep_line(regex, current, newline - current);
+
+        current = newline + 1;
+    }
 }
 
-void grep(char *pattern, Stream *stream)
+static Result grep(Regex &regex, Stream *stream)
 {
-    char *q;
+    // Big reads straight into our buffer instead of going through the stream's.
+    stream_set_read_buffer_mode(stream, STREAM_BUFFERED_NONE);
 
-    char buffer[1024];
-    size_t file_offset = 0;
-    size_t text_read = stream_read(stream, buffer + file_offset, sizeof(buffer) - file_offset - 1);
+    size_t capacity = GREP_BUFFER_SIZE;
+    size_t used = 0;
+    char *buffer = (char *)malloc(capacity);
 
-    while (text_read > 0)
+    while (true)
     {
-        file_offset += text_read;
-        buffer[file_offset] = '\0';
-        char *p = buffer;
-
-        while ((q = strchr(p, '\n')) != 0)
+        if (used == capacity)
         {
-            *q = 0;
+            // A single line doesn't fit.
+            capacity *= 2;
+            buffer = (char *)realloc(buffer, capacity);
+        }
 
-            if (match(pattern, p))
-            {
-                *q = '\n';
-                stream_write(out_stream, p, q + 1 - p);
-            }
+        size_t size = stream_read(stream, buffer + used, capacity - used);
 
-            p = q + 1;
+        if (handle_has_error(stream))
+        {
+            free(buffer);
+            return handle_get_error(stream);
         }
 
-        if (p == buffer)
+        if (size == 0)
         {
-            file_offset = 0;
+            break;
         }
 
-        if (file_offset > 0)
+        used += size;
+
+        // The last line waits for the next read if it isn't complete.
+        size_t complete = used;
+
+        while (complete > 0 && buffer[complete - 1] != '\n')
         {
-            file_offset -= p - buffer;
-            memmove(buffer, p, file_offset);
+            complete--;
         }
 
-        text_read = stream_read(stream, buffer + file_offset, sizeof(buffer) - file_offset - 1);
+        grep_lines(regex, buffer, complete);
+
+        memmove(buffer, buffer + complete, used - complete);
+        used -= complete;
+    }
+
+    if (used > 0)
+    {
+        grep_line(regex, buffer, used);
     }
+
+    free(buffer);
+
+    return SUCCESS;
 }
 
 int main(int argc, char *argv[])
@@ -111,11 +112,19 @@ int main(int argc, char *argv[])
         return 0;
     }
 
-    char *pattern = argv[1];
+    auto regex_or_error = Regex::compile(argv[1]);
+
+    if (!regex_or_error.success())
+    {
+        stream_format(err_stream, "grep: invalid pattern %s\n", argv[1]);
+        return -1;
+    }
+
+    auto regex = regex_or_error.take_value();
 
     if (argc <= 2)
     {
-        grep(pattern, in_stream);
+        grep(*regex, in_stream);
         return 0;
     }
 
@@ -131,7 +140,14 @@ int main(int argc, char *argv[])
             return -1;
         }
 
-        grep(pattern, stream);
+        if (grep(*regex, stream) != SUCCESS)
+        {
+            handle_printf_error(stream, "grep: cannot read %s", argv[i]);
+            stream_close(stream);
+
+            return -1;
+        }
+
         stream_close(stream);
     }
 
@@ -9,5 +9,5 @@ void svg_draw(Painter &painter, Rectangle, float)
 
     graphic::Rasterizer rast{};
 
-    rast.stroke(painter, p, {0, 0}, t, Colors::WHITE);
+    rast.fill(painter, p, {0, 0}, t, Colors::WHITE);
 }
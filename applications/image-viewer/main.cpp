@@ -1,6 +1,11 @@
+#include <libgraphic/png/PNGDecoder.h>
+#include <libsystem/eventloop/Timer.h>
 #include <libwidget/Application.h>
+#include <libwidget/Screen.h>
 #include <libwidget/Widgets.h>
 
+#define IMAGE_VIEWER_ROWS_PER_STEP 32
+
 int main(int argc, char **argv)
 {
     if (argc == 1)
@@ -15,7 +20,37 @@ int main(int argc, char **argv)
     window->title("Image Viewer");
     window->size(Vec2i(700, 500));
 
-    new Image(window->root(), Bitmap::load_from_or_placeholder(argv[1]));
+    // Pngs are decoded a few rows at the time, so large images show up
+    // while they are decoded. Images larger than the screen are downscaled
+    // on the fly instead of being decoded at full size.
+    auto decoder = own<PNGDecoder>(argv[1]);
+
+    Rectangle screen = Screen::bound();
+    int scale = MAX((decoder->width() + screen.width() - 1) / MAX(screen.width(), 1),
+                    (decoder->height() + screen.height() - 1) / MAX(screen.height(), 1));
+
+    OwnPtr<Timer> decode_timer = nullptr;
+
+    if (decoder->begin(scale) == SUCCESS)
+    {
+        auto image = new Image(window->root(), decoder->bitmap());
+
+        decode_timer = own<Timer>(16, [&, image]() {
+            decoder->decode(IMAGE_VIEWER_ROWS_PER_STEP);
+            image->should_repaint();
+
+            if (decoder->done())
+            {
+                decode_timer->stop();
+            }
+        });
+
+        decode_timer->start();
+    }
+    else
+    {
+        new Image(window->root(), Bitmap::load_from_or_placeholder(argv[1]));
+    }
 
     window->show();
 
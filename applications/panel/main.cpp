@@ -15,12 +15,12 @@ int main(int argc, char **argv)
 {
     application_initialize(argc, argv);
 
-    Window *window = new Window(WINDOW_BORDERLESS | WINDOW_ALWAYS_FOCUSED | WINDOW_TRANSPARENT);
+    Window *window = new Window(WINDOW_BORDERLESS | WINDOW_ALWAYS_FOCUSED | WINDOW_TRANSPARENT | WINDOW_ACRYLIC);
 
     window->title("Panel");
     window->type(WINDOW_TYPE_PANEL);
     window->bound(Screen::bound().take_top(PANEL_HEIGHT));
-    window->opacity(0.95);
+    window->opacity(0.85);
     window->on(Event::DISPLAY_SIZE_CHANGED, [&](auto) {
         window->bound(Screen::bound().take_top(PANEL_HEIGHT));
     });
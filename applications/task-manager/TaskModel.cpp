@@ -12,9 +12,20 @@ enum Column
     __COLUMN_COUNT,
 };
 
+TaskModel::TaskModel()
+{
+    _processes = stream_open("/System/processes", OPEN_READ);
+}
+
+TaskModel::~TaskModel()
+{
+    stream_close(_processes);
+    free(_tasks);
+}
+
 int TaskModel::rows()
 {
-    return _data.length();
+    return _count;
 }
 
 int TaskModel::columns()
@@ -48,15 +59,15 @@ String TaskModel::header(int column)
 
 Variant TaskModel::data(int row, int column)
 {
-    auto &task = _data.get((size_t)row);
+    auto &task = _tasks[row];
 
     switch (column)
     {
     case COLUMN_ID:
     {
-        Variant value = task.get("id").as_integer();
+        Variant value = task.id;
 
-        if (task.get("user").is(json::TRUE))
+        if (task.user)
         {
             return value.with_icon(Icon::get("account"));
         }
@@ -67,16 +78,16 @@ Variant TaskModel::data(int row, int column)
     }
 
     case COLUMN_NAME:
-        return task.get("name").as_string();
+        return String(task.name);
 
     case COLUMN_STATE:
-        return task.get("state").as_string();
+        return task_state_string(task.state);
 
     case COLUMN_CPU:
-        return Variant("%2d%%", task.get("cpu").as_integer());
+        return Variant("%2d%%", task.cpu);
 
     case COLUMN_RAM:
-        return Variant("%5d Kio", task.get("ram").as_integer() / 1024);
+        return Variant("%5d Kio", (int)(task.ram / 1024));
 
     default:
         ASSERT_NOT_REACHED();
@@ -85,20 +96,48 @@ Variant TaskModel::data(int row, int column)
 
 void TaskModel::update()
 {
-    _data = json::parse_file("/System/processes");
+    IOCallProcessesSnapshotArgs snapshot{};
+    snapshot.version = TASK_STATS_VERSION;
+
+    // The kernel counts all the tasks even when they don't fit,
+    // so the buffer only has to grow when tasks were spawned.
+    do
+    {
+        if (snapshot.count > _capacity)
+        {
+            _capacity = snapshot.count + 16;
+            _tasks = (TaskStats *)realloc(_tasks, _capacity * sizeof(TaskStats));
+        }
+
+        snapshot.tasks = _tasks;
+        snapshot.capacity = _capacity;
+
+        if (stream_call(_processes, IOCALL_PROCESSES_GET_SNAPSHOT, &snapshot) != SUCCESS)
+        {
+            snapshot.count = 0;
+            break;
+        }
+    } while (snapshot.count > _capacity);
+
+    _count = snapshot.count;
+
     did_update();
 }
 
-static String greedy(json::Value &data, const char *field)
+template <typename TField>
+static String greedy(TaskStats *tasks, size_t count, TField TaskStats::*field)
 {
+    if (count == 0)
+    {
+        return "";
+    }
+
     size_t most_greedy_index = 0;
-    int most_greedy_value = 0;
+    TField most_greedy_value = 0;
 
-    for (size_t i = 0; i < data.length(); i++)
+    for (size_t i = 0; i < count; i++)
     {
-        auto &task = data.get(i);
-
-        auto value = task.get(field).as_integer();
+        auto value = tasks[i].*field;
 
         if (value > most_greedy_value)
         {
@@ -107,20 +146,17 @@ static String greedy(json::Value &data, const char *field)
         }
     }
 
-    return data
-        .get(most_greedy_index)
-        .get("name")
-        .as_string();
+    return tasks[most_greedy_index].name;
 }
 
 String TaskModel::ram_greedy()
 {
-    return greedy(_data, "ram");
+    return greedy(_tasks, _count, &TaskStats::ram);
 }
 
 String TaskModel::cpu_greedy()
 {
-    return greedy(_data, "cpu");
+    return greedy(_tasks, _count, &TaskStats::cpu);
 }
 
 void TaskModel::kill_task(int row)
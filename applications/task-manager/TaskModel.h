@@ -1,14 +1,24 @@
 #pragma once
 
-#include <libsystem/json/Json.h>
+#include <abi/Task.h>
+#include <libsystem/io/Stream.h>
 #include <libwidget/model/TableModel.h>
 
 class TaskModel : public TableModel
 {
 private:
-    json::Value _data;
+    // Kept open between updates, the snapshot is taken with an IOCall on it.
+    Stream *_processes = nullptr;
+
+    TaskStats *_tasks = nullptr;
+    size_t _capacity = 0;
+    size_t _count = 0;
 
 public:
+    TaskModel();
+
+    ~TaskModel();
+
     int rows() override;
 
     int columns() override;
@@ -111,3 +111,68 @@ void render_cell(Painter &painter, int x, int y, terminal::Cell cell)
 {
     render_cell(painter, x, y, cell.codepoint, cell.attributes.foreground, cell.attributes.background, cell.attributes);
 }
+
+void render_line(Painter &painter, int y, const terminal::Cell *cells, int width)
+{
+    RefPtr<Font> mono = font();
+
+    // Cells with the same attributes share their background, underline and colors.
+    int start = 0;
+
+    while (start < width)
+    {
+        terminal::Attributes attributes = cells[start].attributes;
+
+        int end = start + 1;
+
+        while (end < width && cells[end].attributes == attributes)
+        {
+            end++;
+        }
+
+        terminal::Color foreground = attributes.foreground;
+        terminal::Color background = attributes.background;
+
+        if (attributes.invert)
+        {
+            swap(foreground, background);
+        }
+
+        Rectangle bound = cell_bound(start, y).merged_with(cell_bound(end - 1, y));
+
+        if (background != terminal::BACKGROUND)
+        {
+            painter.clear_rectangle(bound, color(background));
+        }
+
+        Color foreground_color = color(foreground);
+
+        if (attributes.underline)
+        {
+            painter.draw_line(
+                bound.position() + Vec2i(0, 13),
+                bound.position() + Vec2i(bound.width(), 13),
+                foreground_color);
+        }
+
+        for (int x = start; x < end; x++)
+        {
+            if (cells[x].codepoint == U' ')
+            {
+                continue;
+            }
+
+            Glyph &glyph = mono->glyph(cells[x].codepoint);
+            Vec2i position = cell_bound(x, y).position() + Vec2i(0, 12);
+
+            painter.draw_glyph(*mono, glyph, position, foreground_color);
+
+            if (attributes.bold)
+            {
+                painter.draw_glyph(*mono, glyph, position + Vec2i(1, 0), foreground_color);
+            }
+        }
+
+        start = end;
+    }
+}
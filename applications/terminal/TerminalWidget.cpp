@@ -9,21 +9,47 @@
 
 #define TERMINAL_IO_BUFFER_SIZE 4096
 
+#define TERMINAL_DRAIN_BUDGET (256 * 1024)
+
+static bool stream_can_read(Stream *stream)
+{
+    Handle *handle = HANDLE(stream);
+    PollEvent events = POLL_READ;
+
+    Handle *selected = nullptr;
+    PollEvent selected_events = 0;
+
+    return handle_poll(&handle, &events, 1, &selected, &selected_events, 0) == SUCCESS;
+}
+
 void terminal_widget_server_callback(TerminalWidget *widget, Stream *server, PollEvent events)
 {
     __unused(events);
 
     char buffer[TERMINAL_IO_BUFFER_SIZE];
-    size_t size = stream_read(server, buffer, TERMINAL_IO_BUFFER_SIZE);
 
-    if (handle_has_error(server))
+    // Take everything the shell wrote so far, but go back to the event loop
+    // once in a while so keyboard input is still handled when it never stops.
+    size_t drained = 0;
+
+    do
     {
-        handle_printf_error(server, "Terminal: read from server failed");
-        return;
-    }
+        size_t size = stream_read(server, buffer, TERMINAL_IO_BUFFER_SIZE);
 
-    widget->terminal()->write(buffer, size);
-    widget->should_repaint();
+        if (handle_has_error(server))
+        {
+            handle_printf_error(server, "Terminal: read from server failed");
+            return;
+        }
+
+        if (size == 0)
+        {
+            return;
+        }
+
+        widget->write(buffer, size);
+        drained += size;
+    } while (drained < TERMINAL_DRAIN_BUDGET && stream_can_read(server));
 }
 
 TerminalWidget::TerminalWidget(Widget *parent) : Widget(parent)
@@ -44,13 +70,27 @@ TerminalWidget::TerminalWidget(Widget *parent) : Widget(parent)
         blink();
 
         int cx = terminal()->cursor().x;
-        int cy = terminal()->cursor().y;
+        int cy = terminal()->cursor().y + _scroll_offset;
 
         should_repaint(cell_bound(cx, cy).offset(bound().position()));
     });
 
     _cursor_blink_timer->start();
 
+    // A timer that was stopped fires on the next turn of the event loop,
+    // so the first output after a pause, like an echo, shows up right away.
+    _repaint_timer = own<Timer>(1000 / 60, [this]() {
+        if (_damaged)
+        {
+            _damaged = false;
+            should_repaint_dirty_lines();
+        }
+        else
+        {
+            _repaint_timer->stop();
+        }
+    });
+
     Launchpad *shell_launchpad = launchpad_create("shell", "/Applications/shell/shell");
     launchpad_handle(shell_launchpad, HANDLE(_client_stream), 0);
     launchpad_handle(shell_launchpad, HANDLE(_client_stream), 1);
@@ -61,6 +101,7 @@ TerminalWidget::TerminalWidget(Widget *parent) : Widget(parent)
 TerminalWidget::~TerminalWidget()
 {
     delete _terminal;
+    delete[] _history;
 
     notifier_destroy(_server_notifier);
 
@@ -78,23 +119,44 @@ void TerminalWidget::paint(Painter &painter, Rectangle rectangle)
     rectangle = rectangle.offset(-bound().position());
 
     terminal::Terminal *terminal = _terminal;
+    terminal::Scrollback &scrollback = terminal->scrollback();
+
+    follow_scrollback();
+
+    int first_line = MAX(0, rectangle.top() / cell_size().y());
+    int last_line = MIN(terminal->height() - 1, (rectangle.bottom() - 1) / cell_size().y());
 
-    for (int y = 0; y < terminal->height(); y++)
+    for (int y = first_line; y <= last_line; y++)
     {
-        for (int x = 0; x < terminal->width(); x++)
+        int line = y - _scroll_offset;
+
+        if (line < 0)
         {
-            terminal::Cell cell = terminal->cell_at(x, y);
-            render_cell(painter, x, y, cell);
-            terminal->cell_undirty(x, y);
+            if (_history_width != terminal->width())
+            {
+                delete[] _history;
+                _history = new terminal::Cell[terminal->width()];
+                _history_width = terminal->width();
+            }
+
+            scrollback.line(scrollback.count() + line, _history, terminal->width());
+            render_line(painter, y, _history, terminal->width());
+        }
+        else
+        {
+            render_line(painter, y, terminal->line_at(line), terminal->width());
+            terminal->line_undirty(line);
         }
     }
 
     int cx = terminal->cursor().x;
-    int cy = terminal->cursor().y;
+    int cy = terminal->cursor().y + _scroll_offset;
 
     if (cell_bound(cx, cy).colide_with(rectangle))
     {
-        terminal::Cell cell = terminal->cell_at(cx, cy);
+        _painted_cursor_line = cy;
+
+        terminal::Cell cell = terminal->cell_at(cx, cy - _scroll_offset);
 
         if (window()->focused())
         {
@@ -131,8 +193,40 @@ void TerminalWidget::event(Event *event)
         event->accepted = true;
     };
 
+    if (event->type == Event::KEYBOARD_KEY_TYPED &&
+        event->keyboard.modifiers & KEY_MODIFIER_SHIFT)
+    {
+        event->accepted = true;
+
+        switch (event->keyboard.key)
+        {
+        case KEYBOARD_KEY_PGUP:
+            scroll(_terminal->height() / 2);
+            return;
+
+        case KEYBOARD_KEY_PGDOWN:
+            scroll(-_terminal->height() / 2);
+            return;
+
+        case KEYBOARD_KEY_UP:
+            scroll(1);
+            return;
+
+        case KEYBOARD_KEY_DOWN:
+            scroll(-1);
+            return;
+
+        default:
+            event->accepted = false;
+            break;
+        }
+    }
+
     if (event->type == Event::KEYBOARD_KEY_TYPED)
     {
+        // Typing brings the screen back into view.
+        scroll(-_scroll_offset);
+
         switch (event->keyboard.key)
         {
         case KEYBOARD_KEY_DELETE:
@@ -236,6 +330,71 @@ void TerminalWidget::event(Event *event)
     }
 }
 
+void TerminalWidget::follow_scrollback()
+{
+    terminal::Scrollback &scrollback = _terminal->scrollback();
+
+    // The offset is counted from the bottom, so lines pushed while scrolled
+    // back are added to it, to keep the same lines on screen.
+    if (_scroll_offset > 0)
+    {
+        size_t pushed = scrollback.pushed() - _scrollback_pushed;
+        _scroll_offset += (int)MIN(pushed, (size_t)scrollback.count());
+    }
+
+    _scroll_offset = MIN(_scroll_offset, scrollback.count());
+    _scrollback_pushed = scrollback.pushed();
+}
+
+void TerminalWidget::scroll(int lines)
+{
+    follow_scrollback();
+
+    int offset = clamp(_scroll_offset + lines, 0, _terminal->scrollback().count());
+
+    if (offset != _scroll_offset)
+    {
+        _scroll_offset = offset;
+        should_repaint();
+    }
+}
+
+void TerminalWidget::write(const char *buffer, size_t size)
+{
+    _terminal->write(buffer, size);
+
+    _damaged = true;
+    _repaint_timer->start();
+}
+
+void TerminalWidget::should_repaint_dirty_lines()
+{
+    if (_scroll_offset > 0)
+    {
+        // Everything on screen moves when new lines are pushed to the scrollback.
+        should_repaint();
+        return;
+    }
+
+    int cursor_line = _terminal->cursor().y;
+
+    int first = MIN(cursor_line, _painted_cursor_line);
+    int last = MAX(cursor_line, _painted_cursor_line);
+
+    for (int y = 0; y < _terminal->height(); y++)
+    {
+        if (_terminal->line_dirty(y))
+        {
+            first = MIN(first, y);
+            last = MAX(last, y);
+        }
+    }
+
+    Rectangle dirty = cell_bound(0, first).merged_with(cell_bound(_terminal->width() - 1, last));
+
+    should_repaint(dirty.offset(bound().position()));
+}
+
 void TerminalWidget::do_layout()
 {
     int width = bound().width() / cell_size().x();
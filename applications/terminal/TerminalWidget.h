@@ -13,10 +13,28 @@ private:
     terminal::Terminal *_terminal;
     bool _cursor_blink;
 
+    // How many lines of the scrollback are shown above the screen.
+    int _scroll_offset = 0;
+
+    // Scrollback::pushed() when the offset was last brought up to date.
+    size_t _scrollback_pushed = 0;
+
+    // Scrollback lines are decoded here to be painted, it's only
+    // allocated once one is shown and reused until the width changes.
+    terminal::Cell *_history = nullptr;
+    int _history_width = 0;
+
+    // Where the cursor was last painted, to erase it when it moves.
+    int _painted_cursor_line = 0;
+
     Stream *_server_stream;
     Stream *_client_stream;
 
     OwnPtr<Timer> _cursor_blink_timer;
+
+    // Output is painted at most once per frame, however fast it comes.
+    OwnPtr<Timer> _repaint_timer;
+    bool _damaged = false;
     Notifier *_server_notifier;
 
 public:
@@ -24,6 +42,14 @@ public:
 
     void blink() { _cursor_blink = !_cursor_blink; };
 
+    void follow_scrollback();
+
+    void scroll(int lines);
+
+    void should_repaint_dirty_lines();
+
+    void write(const char *buffer, size_t size);
+
     TerminalWidget(Widget *parent);
 
     ~TerminalWidget();
@@ -5,7 +5,14 @@ ICONS_AT_24PX = $(patsubst icons/%.svg, $(SYSROOT)/Files/Icons/%@24px.png, $(ICO
 ICONS_AT_36PX = $(patsubst icons/%.svg, $(SYSROOT)/Files/Icons/%@36px.png, $(ICONS))
 ICONS_AT_48PX = $(patsubst icons/%.svg, $(SYSROOT)/Files/Icons/%@48px.png, $(ICONS))
 
-TARGETS += $(ICONS_AT_18PX) $(ICONS_AT_24PX) $(ICONS_AT_36PX) $(ICONS_AT_48PX)
+ICONS_BITMAPS = $(patsubst %.png, %.bitmap, $(ICONS_AT_18PX) $(ICONS_AT_24PX) $(ICONS_AT_36PX) $(ICONS_AT_48PX))
+
+TARGETS += $(ICONS_AT_18PX) $(ICONS_AT_24PX) $(ICONS_AT_36PX) $(ICONS_AT_48PX) $(ICONS_BITMAPS)
+
+$(SYSROOT)/Files/Icons/%.bitmap: $(SYSROOT)/Files/Icons/%.png
+	$(DIRECTORY_GUARD)
+	@echo [BitmapCompiler] $(notdir $@)
+	@bitmap-compiler.py $< $@
 
 $(SYSROOT)/Files/Icons/%@18px.png: icons/%.svg
 	$(DIRECTORY_GUARD)
@@ -2,7 +2,7 @@
 #include <libsystem/Logger.h>
 #include <libsystem/Result.h>
 #include <libsystem/core/CString.h>
-#include <libsystem/json/Json.h>
+#include <libsystem/json/Writer.h>
 #include <libsystem/math/MinMax.h>
 
 #include "kernel/devices/Devices.h"
@@ -17,31 +17,31 @@ FsDeviceInfo::FsDeviceInfo() : FsNode(FILE_TYPE_DEVICE)
 
 Result FsDeviceInfo::open(FsHandle *handle)
 {
-    json::Array root{};
+    StringBuilder builder{4096};
+    json::Writer writer{builder};
 
-    device_iterate([&](RefPtr<Device> device) {
-        json::Object device_object{};
+    writer.begin_array();
 
+    device_iterate([&](RefPtr<Device> device) {
         auto *driver = driver_for(device->address());
 
-        __unused(device);
+        writer.begin_object();
 
-        device_object["name"] = device->name().cstring();
-        device_object["path"] = device->path().cstring();
-        device_object["address"] = device->address().as_static_cstring();
-        device_object["interrupt"] = device->interrupt();
-        device_object["refcount"] = device->refcount();
-        device_object["description"] = driver->name();
+        writer.member("name", device->name());
+        writer.member("path", device->path());
+        writer.member("address", device->address().as_static_cstring());
+        writer.member("interrupt", device->interrupt());
+        writer.member("refcount", device->refcount());
+        writer.member("description", driver->name());
 
-        root.push_back(device_object);
+        writer.end_object();
 
         return Iteration::CONTINUE;
     });
 
-    Prettifier pretty{};
-    json::prettify(pretty, root);
+    writer.end_array();
 
-    handle->attached = pretty.finalize().underlying_storage().give_ref();
+    handle->attached = builder.finalize().underlying_storage().give_ref();
     handle->attached_size = reinterpret_cast<StringStorage *>(handle->attached)->length();
 
     return SUCCESS;
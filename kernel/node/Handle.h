@@ -11,8 +11,8 @@ private:
     size_t _offset = 0;
 
 public:
-    void *attached;
-    size_t attached_size;
+    void *attached = nullptr;
+    size_t attached_size = 0;
 
     auto node() { return _node; }
 
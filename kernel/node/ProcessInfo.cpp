@@ -2,7 +2,7 @@
 #include <libsystem/Logger.h>
 #include <libsystem/Result.h>
 #include <libsystem/core/CString.h>
-#include <libsystem/json/Json.h>
+#include <libsystem/json/Writer.h>
 #include <libsystem/math/MinMax.h>
 
 #include "kernel/filesystem/Filesystem.h"
@@ -10,47 +10,33 @@
 #include "kernel/node/Handle.h"
 #include "kernel/node/ProcessInfo.h"
 #include "kernel/scheduling/Scheduler.h"
+#include "kernel/tasking/Syscalls.h"
 #include "kernel/tasking/Task-Memory.h"
 
 FsProcessInfo::FsProcessInfo() : FsNode(FILE_TYPE_DEVICE)
 {
 }
 
-static Iteration serialize_task(json::Array *list, Task *task)
+static Iteration serialize_task(json::Writer *writer, Task *task)
 {
     if (task->id == 0)
         return Iteration::CONTINUE;
 
-    json::Object task_object{};
+    writer->begin_object();
 
-    task_object["id"] = task->id;
-    task_object["name"] = task->name;
-    task_object["state"] = task_state_string(task->state());
-    task_object["directory"] = "";
-    task_object["cpu"] = scheduler_get_usage(task->id);
-    task_object["ram"] = (int)task_memory_usage(task);
-    task_object["user"] = task->user;
+    writer->member("id", task->id);
+    writer->member("name", task->name);
+    writer->member("state", task_state_string(task->state()));
+    writer->member("directory", "");
+    writer->member("cpu", scheduler_get_usage(task->id));
+    writer->member("ram", (int)task_memory_usage(task));
+    writer->member("user", task->user);
 
-    list->push_back(move(task_object));
+    writer->end_object();
 
     return Iteration::CONTINUE;
 }
 
-Result FsProcessInfo::open(FsHandle *handle)
-{
-    json::Array list{};
-
-    task_iterate(&list, (TaskIterateCallback)serialize_task);
-
-    Prettifier pretty{};
-    json::prettify(pretty, list);
-
-    handle->attached = pretty.finalize().underlying_storage().give_ref();
-    handle->attached_size = reinterpret_cast<StringStorage *>(handle->attached)->length();
-
-    return SUCCESS;
-}
-
 void FsProcessInfo::close(FsHandle *handle)
 {
     deref_if_not_null(reinterpret_cast<StringStorage *>(handle->attached));
@@ -58,6 +44,22 @@ void FsProcessInfo::close(FsHandle *handle)
 
 ResultOr<size_t> FsProcessInfo::read(FsHandle &handle, void *buffer, size_t size)
 {
+    // The json is only written on the first read, handles only used
+    // for IOCALL_PROCESSES_GET_SNAPSHOT never pay for it.
+    if (handle.attached == nullptr)
+    {
+        // Written straight to the buffer readers are served from, without building Values.
+        StringBuilder builder{4096};
+        json::Writer writer{builder};
+
+        writer.begin_array();
+        task_iterate(&writer, (TaskIterateCallback)serialize_task);
+        writer.end_array();
+
+        handle.attached = builder.finalize().underlying_storage().give_ref();
+        handle.attached_size = reinterpret_cast<StringStorage *>(handle.attached)->length();
+    }
+
     size_t read = 0;
 
     if (handle.offset() <= handle.attached_size)
@@ -69,6 +71,91 @@ ResultOr<size_t> FsProcessInfo::read(FsHandle &handle, void *buffer, size_t size
     return read;
 }
 
+static Iteration snapshot_task(IOCallProcessesSnapshotArgs *snapshot, Task *task)
+{
+    if (task->id == 0)
+        return Iteration::CONTINUE;
+
+    // Keep counting past the capacity, so the caller knows how much room to make.
+    if (snapshot->count < snapshot->capacity)
+    {
+        TaskStats &stats = snapshot->tasks[snapshot->count];
+
+        stats.id = task->id;
+        stats.user = task->user;
+        stats.state = task->state();
+        strlcpy(stats.name, task->name, PROCESS_NAME_SIZE);
+
+        stats.cpu_ticks = task->cpu_ticks;
+        stats.cpu = scheduler_get_usage(task->id);
+        stats.ram = task_memory_usage(task);
+
+        stats.handles = 0;
+
+        for (size_t i = 0; i < PROCESS_HANDLE_COUNT; i++)
+        {
+            if (task->handles[i] != nullptr)
+            {
+                stats.handles++;
+            }
+        }
+    }
+
+    snapshot->count++;
+
+    return Iteration::CONTINUE;
+}
+
+Result FsProcessInfo::call(FsHandle &handle, IOCall request, void *args)
+{
+    __unused(handle);
+
+    if (request != IOCALL_PROCESSES_GET_SNAPSHOT)
+    {
+        return ERR_INAPPROPRIATE_CALL_FOR_DEVICE;
+    }
+
+    if (!syscall_validate_ptr((uintptr_t)args, sizeof(IOCallProcessesSnapshotArgs)))
+    {
+        return ERR_BAD_ADDRESS;
+    }
+
+    // The caller can change its copy at any time, so the fields are read
+    // once into ours, validated, and only count and system are written back.
+    auto *user_snapshot = reinterpret_cast<IOCallProcessesSnapshotArgs *>(args);
+
+    IOCallProcessesSnapshotArgs snapshot = {};
+    snapshot.version = user_snapshot->version;
+    snapshot.tasks = user_snapshot->tasks;
+    snapshot.capacity = user_snapshot->capacity;
+
+    if (snapshot.version != TASK_STATS_VERSION)
+    {
+        return ERR_OPERATION_NOT_SUPPORTED;
+    }
+
+    // A huge capacity would wrap around and pass the check below.
+    if (snapshot.capacity > SIZE_MAX / sizeof(TaskStats))
+    {
+        return ERR_BAD_ADDRESS;
+    }
+
+    if (snapshot.capacity > 0 &&
+        !syscall_validate_ptr((uintptr_t)snapshot.tasks, snapshot.capacity * sizeof(TaskStats)))
+    {
+        return ERR_BAD_ADDRESS;
+    }
+
+    task_iterate(&snapshot, (TaskIterateCallback)snapshot_task);
+
+    Result result = hj_system_status(&snapshot.system);
+
+    user_snapshot->count = snapshot.count;
+    user_snapshot->system = snapshot.system;
+
+    return result;
+}
+
 void process_info_initialize()
 {
     filesystem_link(Path::parse("/System/processes"), make<FsProcessInfo>());
@@ -8,10 +8,10 @@ private:
 public:
     FsProcessInfo();
 
-    Result open(FsHandle *handle) override;
-
     void close(FsHandle *handle) override;
 
+    Result call(FsHandle &handle, IOCall request, void *args) override;
+
     ResultOr<size_t> read(FsHandle &handle, void *buffer, size_t size) override;
 };
 
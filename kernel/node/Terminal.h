@@ -8,7 +8,7 @@
 class FsTerminal : public FsNode
 {
 private:
-    static constexpr int BUFFER_SIZE = 1024;
+    static constexpr int BUFFER_SIZE = 4096;
 
     int _width = 80;
     int _height = 25;
@@ -132,6 +132,7 @@ uintptr_t schedule(uintptr_t current_stack_pointer)
     arch_save_context(running);
 
     scheduler_record[system_get_tick() % SCHEDULER_RECORD_COUNT] = running->id;
+    running->cpu_ticks++;
 
     list_iterate(blocked_tasks, nullptr, (ListIterationCallback)wakeup_task_if_unblocked);
 
@@ -4,4 +4,6 @@
 
 #include <libsystem/Common.h>
 
+bool syscall_validate_ptr(uintptr_t ptr, size_t size);
+
 int task_do_syscall(Syscall syscall, int arg0, int arg1, int arg2, int arg3, int arg4);
@@ -20,6 +20,8 @@ struct Task
     TaskState _state;
     Blocker *blocker;
 
+    uint32_t cpu_ticks;
+
     uintptr_t user_stack_pointer;
     void *user_stack;
 
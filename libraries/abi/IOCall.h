@@ -1,6 +1,8 @@
 #pragma once
 
 #include <abi/Network.h>
+#include <abi/System.h>
+#include <abi/Task.h>
 
 struct IOCallTerminalSizeArgs
 {
@@ -45,6 +47,17 @@ struct IOCallNetworkSateAgs
     MacAddress mac_address;
 };
 
+struct IOCallProcessesSnapshotArgs
+{
+    uint32_t version; // TASK_STATS_VERSION, the layout the caller expects.
+
+    TaskStats *tasks;
+    size_t capacity;
+    size_t count; // How many tasks there are, even if more than capacity.
+
+    SystemStatus system;
+};
+
 enum IOCall
 {
     IOCALL_TERMINAL_GET_SIZE,
@@ -62,5 +75,7 @@ enum IOCall
 
     IOCALL_NETWORK_GET_STATE,
 
+    IOCALL_PROCESSES_GET_SNAPSHOT,
+
     __IOCALL_COUNT,
 };
@@ -18,6 +18,22 @@ enum TaskState
         __TASK_STATE_COUNT
 };
 
+#define TASK_STATS_VERSION 1
+
+// A fixed layout snapshot of a task, for tools sampling often.
+struct TaskStats
+{
+    int id;
+    bool user;
+    TaskState state;
+    char name[PROCESS_NAME_SIZE];
+
+    uint32_t cpu_ticks; // Ticks spent running since the task was created.
+    int cpu;            // Percentage over the last scheduler records.
+    size_t ram;
+    int handles;
+};
+
 static inline const char *task_state_string(TaskState state)
 {
 #define TASK_STATE_STRING_ENTRY(__state) #__state,
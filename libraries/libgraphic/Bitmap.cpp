@@ -7,12 +7,31 @@
 #undef LODEPNG_NO_COMPILE_DISK
 
 #include <libgraphic/Bitmap.h>
+#include <libgraphic/png/PNGDecoder.h>
 #include <libsystem/Assert.h>
 #include <libsystem/Logger.h>
 #include <libsystem/Result.h>
+#include <libsystem/core/CString.h>
 #include <libsystem/io/File.h>
+#include <libsystem/io/Stream.h>
 #include <libsystem/system/Memory.h>
 
+#define BITMAP_RAW_MAGIC "BMAP"
+#define BITMAP_RAW_EXTENSION ".bitmap"
+#define BITMAP_PNG_EXTENSION ".png"
+
+// Keeps width * height * 4 from overflowing.
+#define BITMAP_RAW_MAX_SIZE 16384
+
+// Header of the raw bitmaps produced by toolbox/bitmap-compiler.py, the
+// RGBA pixels follow it.
+struct BitmapRawHeader
+{
+    char magic[4];
+    uint32_t width;
+    uint32_t height;
+};
+
 static Color _placeholder_buffer[] = {
     Colors::MAGENTA,
     Colors::BLACK,
@@ -61,7 +80,94 @@ RefPtr<Bitmap> Bitmap::create_static(int width, int height, Color *pixels)
     return make<Bitmap>(-1, BITMAP_STATIC, width, height, pixels);
 }
 
+static bool bitmap_has_extension(const char *path, const char *extension)
+{
+    size_t path_length = strlen(path);
+    size_t extension_length = strlen(extension);
+
+    return path_length >= extension_length &&
+           strcmp(path + path_length - extension_length, extension) == 0;
+}
+
 ResultOr<RefPtr<Bitmap>> Bitmap::load_from(const char *path)
+{
+    if (bitmap_has_extension(path, BITMAP_RAW_EXTENSION))
+    {
+        return load_from_raw(path);
+    }
+
+    if (bitmap_has_extension(path, BITMAP_PNG_EXTENSION))
+    {
+        // Prefer the raw bitmap generated at build time next to the png.
+        char raw_path[PATH_LENGTH] = {};
+        size_t length = strlen(path) - strlen(BITMAP_PNG_EXTENSION);
+
+        if (length + strlen(BITMAP_RAW_EXTENSION) < PATH_LENGTH)
+        {
+            memcpy(raw_path, path, length);
+            strcpy(raw_path + length, BITMAP_RAW_EXTENSION);
+
+            auto bitmap_or_result = load_from_raw(raw_path);
+
+            if (bitmap_or_result.success())
+            {
+                return bitmap_or_result;
+            }
+        }
+    }
+
+    return load_from_png(path);
+}
+
+ResultOr<RefPtr<Bitmap>> Bitmap::load_from_raw(const char *path)
+{
+    __cleanup(stream_cleanup) Stream *stream = stream_open(path, OPEN_READ);
+
+    if (handle_has_error(stream))
+    {
+        return handle_get_error(stream);
+    }
+
+    BitmapRawHeader header = {};
+
+    if (stream_read(stream, &header, sizeof(BitmapRawHeader)) != sizeof(BitmapRawHeader) ||
+        memcmp(header.magic, BITMAP_RAW_MAGIC, sizeof(header.magic)) != 0)
+    {
+        return ERR_BAD_IMAGE_FILE_FORMAT;
+    }
+
+    // Don't trust the header, it has to describe exactly the pixels in the file.
+    FileState state = {};
+    stream_stat(stream, &state);
+
+    if (header.width == 0 || header.height == 0 ||
+        header.width > BITMAP_RAW_MAX_SIZE || header.height > BITMAP_RAW_MAX_SIZE ||
+        state.size != sizeof(BitmapRawHeader) + sizeof(Color) * header.width * header.height)
+    {
+        return ERR_BAD_IMAGE_FILE_FORMAT;
+    }
+
+    auto bitmap_or_result = Bitmap::create_shared(header.width, header.height);
+
+    if (!bitmap_or_result.success())
+    {
+        return bitmap_or_result;
+    }
+
+    auto bitmap = bitmap_or_result.take_value();
+
+    // There is nothing to decode, the pixels are read straight into the shared memory.
+    size_t size = sizeof(Color) * header.width * header.height;
+
+    if (stream_read(stream, bitmap->pixels(), size) != size)
+    {
+        return ERR_BAD_IMAGE_FILE_FORMAT;
+    }
+
+    return bitmap;
+}
+
+static ResultOr<RefPtr<Bitmap>> bitmap_load_with_lodepng(const char *path)
 {
     void *rawdata;
     size_t rawdata_size;
@@ -104,6 +210,19 @@ ResultOr<RefPtr<Bitmap>> Bitmap::load_from(const char *path)
     }
 }
 
+ResultOr<RefPtr<Bitmap>> Bitmap::load_from_png(const char *path)
+{
+    auto bitmap_or_result = PNGDecoder::load(path);
+
+    // Interlaced images can't be streamed, they are decoded all at once.
+    if (bitmap_or_result.result() == ERR_FUNCTION_NOT_IMPLEMENTED)
+    {
+        return bitmap_load_with_lodepng(path);
+    }
+
+    return bitmap_or_result;
+}
+
 RefPtr<Bitmap> Bitmap::load_from_or_placeholder(const char *path)
 {
     auto result = load_from(path);
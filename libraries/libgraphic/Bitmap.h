@@ -65,6 +65,10 @@ public:
 
     static ResultOr<RefPtr<Bitmap>> load_from(const char *path);
 
+    static ResultOr<RefPtr<Bitmap>> load_from_png(const char *path);
+
+    static ResultOr<RefPtr<Bitmap>> load_from_raw(const char *path);
+
     static RefPtr<Bitmap> load_from_or_placeholder(const char *path);
 
     Result save_to(const char *path);
@@ -0,0 +1,247 @@
+#include <libgraphic/Blur.h>
+#include <libsystem/core/CString.h>
+#include <libsystem/math/MinMax.h>
+
+#define BLUR_PASSES 3
+#define BLUR_STRIP_WIDTH 16
+
+// Keeps the sums of a downsampled block within the 16 bits halves of BlurSum.
+#define BLUR_MAX_SCALE 16
+
+// Red and blue are summed together in the two halves of a single word, the
+// sums never get past 255 * (2 * BLUR_MAX_RADIUS + 1) so the halves can't overflow
+// into each other. Green goes in a second word and alpha is never summed.
+struct BlurSum
+{
+    uint32_t red_blue = 0;
+    uint32_t green = 0;
+
+    void add(uint32_t pixel)
+    {
+        red_blue += pixel & 0x00ff00ff;
+        green += (pixel >> 8) & 0xff;
+    }
+
+    void sub(uint32_t pixel)
+    {
+        red_blue -= pixel & 0x00ff00ff;
+        green -= (pixel >> 8) & 0xff;
+    }
+
+    uint32_t average(uint32_t multiplier, uint32_t alpha)
+    {
+        uint32_t red = ((red_blue & 0xffff) * multiplier) >> 16;
+        uint32_t blue = ((red_blue >> 16) * multiplier) >> 16;
+        uint32_t green_average = (green * multiplier) >> 16;
+
+        return red | (green_average << 8) | (blue << 16) | (alpha & 0xff000000);
+    }
+};
+
+static uint32_t blur_multiplier(int radius)
+{
+    uint32_t divisor = radius * 2 + 1;
+    return ((1 << 16) + divisor - 1) / divisor;
+}
+
+static void blur_horizontal(uint32_t *pixels, int stride, int width, int height, int radius, uint32_t *line)
+{
+    uint32_t multiplier = blur_multiplier(radius);
+
+    for (int y = 0; y < height; y++)
+    {
+        uint32_t *row = pixels + y * stride;
+        memcpy(line, row, width * sizeof(uint32_t));
+
+        BlurSum sum;
+
+        for (int i = -radius; i <= radius; i++)
+        {
+            sum.add(line[clamp(i, 0, width - 1)]);
+        }
+
+        for (int x = 0; x < width; x++)
+        {
+            row[x] = sum.average(multiplier, line[x]);
+
+            sum.add(line[MIN(x + radius + 1, width - 1)]);
+            sum.sub(line[MAX(x - radius, 0)]);
+        }
+    }
+}
+
+// Columns are blurred a strip at the time walking down the rows, so memory
+// is still accessed row by row. The rows that are still needed once they
+// have been overwritten are kept in a small ring.
+static void blur_vertical(uint32_t *pixels, int stride, int width, int height, int radius, uint32_t *ring)
+{
+    uint32_t multiplier = blur_multiplier(radius);
+    int ring_size = radius + 1;
+
+    for (int strip = 0; strip < width; strip += BLUR_STRIP_WIDTH)
+    {
+        int strip_width = MIN(BLUR_STRIP_WIDTH, width - strip);
+        BlurSum sums[BLUR_STRIP_WIDTH];
+
+        for (int i = -radius; i <= radius; i++)
+        {
+            uint32_t *row = pixels + clamp(i, 0, height - 1) * stride + strip;
+
+            for (int x = 0; x < strip_width; x++)
+            {
+                sums[x].add(row[x]);
+            }
+        }
+
+        auto original_row = [&](int current, int y) {
+            if (y > current)
+            {
+                return pixels + y * stride + strip;
+            }
+            else
+            {
+                return ring + (y % ring_size) * BLUR_STRIP_WIDTH;
+            }
+        };
+
+        for (int y = 0; y < height; y++)
+        {
+            uint32_t *row = pixels + y * stride + strip;
+            memcpy(ring + (y % ring_size) * BLUR_STRIP_WIDTH, row, strip_width * sizeof(uint32_t));
+
+            for (int x = 0; x < strip_width; x++)
+            {
+                row[x] = sums[x].average(multiplier, row[x]);
+            }
+
+            uint32_t *entering = original_row(y, MIN(y + radius + 1, height - 1));
+            uint32_t *leaving = original_row(y, MAX(y - radius, 0));
+
+            for (int x = 0; x < strip_width; x++)
+            {
+                sums[x].add(entering[x]);
+                sums[x].sub(leaving[x]);
+            }
+        }
+    }
+}
+
+static void blur_pixels(uint32_t *pixels, int stride, int width, int height, int radius)
+{
+    uint32_t *line = (uint32_t *)malloc(width * sizeof(uint32_t));
+    uint32_t *ring = (uint32_t *)malloc((radius + 1) * BLUR_STRIP_WIDTH * sizeof(uint32_t));
+
+    // Three box blurs of half the radius end up close to a gaussian of the full radius.
+    int box_radius = MAX(1, (radius + 1) / 2);
+
+    for (int i = 0; i < BLUR_PASSES; i++)
+    {
+        blur_horizontal(pixels, stride, width, height, box_radius, line);
+        blur_vertical(pixels, stride, width, height, box_radius, ring);
+    }
+
+    free(line);
+    free(ring);
+}
+
+static void blur_downsample(uint32_t *source, int stride, Rectangle region, uint32_t *destination, int scale)
+{
+    int width = region.width() / scale;
+    int height = region.height() / scale;
+
+    for (int y = 0; y < height; y++)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            BlurSum sum;
+
+            for (int sy = 0; sy < scale; sy++)
+            {
+                uint32_t *row = source + (region.y() + y * scale + sy) * stride + region.x() + x * scale;
+
+                for (int sx = 0; sx < scale; sx++)
+                {
+                    sum.add(row[sx]);
+                }
+            }
+
+            int area = scale * scale;
+
+            destination[y * width + x] = ((sum.red_blue & 0xffff) / area) |
+                                         ((sum.green / area) << 8) |
+                                         (((sum.red_blue >> 16) / area) << 16);
+        }
+    }
+}
+
+static uint32_t blur_lerp(uint32_t a, uint32_t b, uint32_t t)
+{
+    uint32_t red_blue = ((a & 0x00ff00ff) * (256 - t) + (b & 0x00ff00ff) * t) >> 8;
+    uint32_t green = ((a & 0x0000ff00) * (256 - t) + (b & 0x0000ff00) * t) >> 8;
+
+    return (red_blue & 0x00ff00ff) | (green & 0x0000ff00);
+}
+
+static void blur_upsample(uint32_t *source, int width, int height, uint32_t *destination, int stride, Rectangle region)
+{
+    for (int y = 0; y < region.height(); y++)
+    {
+        // Sample positions are in 8 bits fixed point, centered on the source pixels.
+        int sample_y = clamp((((y * 2 + 1) * height * 128) / region.height()) - 128, 0, (height - 1) * 256);
+
+        uint32_t *above = source + (sample_y >> 8) * width;
+        uint32_t *below = source + MIN((sample_y >> 8) + 1, height - 1) * width;
+        uint32_t fraction_y = sample_y & 0xff;
+
+        uint32_t *row = destination + (region.y() + y) * stride + region.x();
+
+        for (int x = 0; x < region.width(); x++)
+        {
+            int sample_x = clamp((((x * 2 + 1) * width * 128) / region.width()) - 128, 0, (width - 1) * 256);
+
+            int left = sample_x >> 8;
+            int right = MIN(left + 1, width - 1);
+            uint32_t fraction_x = sample_x & 0xff;
+
+            uint32_t top = blur_lerp(above[left], above[right], fraction_x);
+            uint32_t bottom = blur_lerp(below[left], below[right], fraction_x);
+
+            row[x] = blur_lerp(top, bottom, fraction_y) | (row[x] & 0xff000000);
+        }
+    }
+}
+
+void blur_bitmap(Bitmap &bitmap, Rectangle region, int radius)
+{
+    region = region.clipped_with(bitmap.bound());
+
+    if (region.is_empty() || radius <= 0)
+    {
+        return;
+    }
+
+    // Color is laid out as red, green, blue, alpha bytes.
+    uint32_t *pixels = reinterpret_cast<uint32_t *>(bitmap.pixels());
+    int stride = bitmap.width();
+
+    int scale = (radius + BLUR_MAX_RADIUS - 1) / BLUR_MAX_RADIUS;
+    scale = MIN(scale, BLUR_MAX_SCALE);
+    scale = MIN(scale, MIN(region.width(), region.height()));
+
+    if (scale <= 1)
+    {
+        blur_pixels(pixels + region.y() * stride + region.x(), stride, region.width(), region.height(), MIN(radius, BLUR_MAX_RADIUS));
+        return;
+    }
+
+    int width = region.width() / scale;
+    int height = region.height() / scale;
+
+    uint32_t *downsampled = (uint32_t *)malloc(width * height * sizeof(uint32_t));
+
+    blur_downsample(pixels, stride, region, downsampled, scale);
+    blur_pixels(downsampled, width, width, height, MIN(radius / scale, BLUR_MAX_RADIUS));
+    blur_upsample(downsampled, width, height, pixels, stride, region);
+
+    free(downsampled);
+}
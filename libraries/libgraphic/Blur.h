@@ -0,0 +1,11 @@
+#pragma once
+
+#include <libgraphic/Bitmap.h>
+
+// Larger radii are blurred on a downsampled copy of the region, the result
+// is indistinguishable once upsampled and the cost stops growing with the radius.
+#define BLUR_MAX_RADIUS 8
+
+// Approximate a gaussian blur of the color channels of region with three
+// separable box blur passes, the alpha channel is left untouched.
+void blur_bitmap(Bitmap &bitmap, Rectangle region, int radius);
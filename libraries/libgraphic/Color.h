@@ -151,6 +151,29 @@ public:
         return from_rgba(r, g, b, a);
     }
 
+    // Blend fg, scaled by an 8-bit coverage, over gb using integer math when gb is opaque.
+    static constexpr Color blend(Color fg, Color gb, uint8_t coverage)
+    {
+        uint32_t alpha = (fg.alpha() * coverage + 127) / 255;
+
+        if (alpha == 0)
+        {
+            return gb;
+        }
+
+        if (gb.alpha() != 0xff)
+        {
+            return blend(fg.with_alpha(alpha / 255.0), gb);
+        }
+
+        uint32_t inverse = 0xff - alpha;
+
+        return from_byte(
+            (fg.red() * alpha + gb.red() * inverse + 127) / 255,
+            (fg.green() * alpha + gb.green() * inverse + 127) / 255,
+            (fg.blue() * alpha + gb.blue() * inverse + 127) / 255);
+    }
+
     static constexpr Color lerp(Color from, Color to, float transition)
     {
         return from_rgba(
@@ -1,4 +1,5 @@
 #include <libgraphic/Font.h>
+#include <libgraphic/FontCache.h>
 #include <libsystem/Assert.h>
 #include <libsystem/Logger.h>
 #include <libsystem/Result.h>
@@ -9,6 +10,13 @@
 
 static HashMap<String, RefPtr<Font>> _fonts;
 
+struct FontCacheHeader
+{
+    int width;
+    int height;
+    size_t glyphs_count;
+};
+
 static ResultOr<Vector<Glyph>> font_load_glyph(String name)
 {
     char glyph_path[PATH_LENGTH];
@@ -34,56 +42,206 @@ static ResultOr<RefPtr<Bitmap>> font_load_bitmap(String name)
     return Bitmap::load_from(bitmap_path);
 }
 
+static Vector<uint8_t> font_compute_coverage(Bitmap &bitmap)
+{
+    size_t size = bitmap.width() * bitmap.height();
+    uint8_t *coverage = (uint8_t *)malloc(size);
+
+    for (size_t i = 0; i < size; i++)
+    {
+        coverage[i] = bitmap.pixels()[i].red();
+    }
+
+    return Vector(ADOPT, coverage, size);
+}
+
+static RefPtr<Font> font_create_from_cache_entry(FontCacheEntry *entry)
+{
+    auto *header = reinterpret_cast<FontCacheHeader *>(entry->data);
+
+    size_t glyphs_size = header->glyphs_count * sizeof(Glyph);
+    size_t coverage_size = (size_t)header->width * header->height;
+
+    if (sizeof(FontCacheHeader) + glyphs_size + coverage_size > entry->size)
+    {
+        font_cache_release(entry);
+        return nullptr;
+    }
+
+    auto *glyphs = reinterpret_cast<Glyph *>(entry->data + sizeof(FontCacheHeader));
+    auto *coverage = entry->data + sizeof(FontCacheHeader) + glyphs_size;
+
+    Vector<Glyph> glyphs_copy(header->glyphs_count);
+
+    for (size_t i = 0; i < header->glyphs_count; i++)
+    {
+        glyphs_copy.push_back(glyphs[i]);
+    }
+
+    // The entry is never released, fonts live as long as the process.
+    return make<Font>(header->width, header->height, coverage, move(glyphs_copy));
+}
+
+static FontCacheEntry *font_publish_to_cache(String name, Vector<Glyph> &glyphs, int width, int height, Vector<uint8_t> &coverage)
+{
+    size_t glyphs_size = glyphs.count() * sizeof(Glyph);
+    size_t coverage_size = coverage.count();
+
+    FontCacheEntry *entry = font_cache_allocate(sizeof(FontCacheHeader) + glyphs_size + coverage_size);
+
+    if (!entry)
+    {
+        return nullptr;
+    }
+
+    auto *header = reinterpret_cast<FontCacheHeader *>(entry->data);
+    header->width = width;
+    header->height = height;
+    header->glyphs_count = glyphs.count();
+
+    memcpy(entry->data + sizeof(FontCacheHeader), glyphs.raw_storage(), glyphs_size);
+    memcpy(entry->data + sizeof(FontCacheHeader) + glyphs_size, coverage.raw_storage(), coverage_size);
+
+    font_cache_publish(name.cstring(), entry);
+
+    return entry;
+}
+
 ResultOr<RefPtr<Font>> Font::create(String name)
 {
-    if (!_fonts.has_key(name))
+    if (_fonts.has_key(name))
     {
-        auto glyph_or_error = font_load_glyph(name);
+        return _fonts[name];
+    }
 
-        if (!glyph_or_error.success())
-        {
-            logger_error("Failed to load font %s: missing glyphs", name.cstring());
-            return glyph_or_error.result();
-        }
+    FontCacheEntry *entry = font_cache_lookup(name.cstring());
 
-        auto bitmap_or_error = font_load_bitmap(name);
+    if (entry)
+    {
+        auto font = font_create_from_cache_entry(entry);
 
-        if (!bitmap_or_error.success())
+        if (font)
         {
-            logger_error("Failed to load font %s: missing bitmap", name.cstring());
-            return bitmap_or_error.result();
+            _fonts[name] = font;
+            return font;
         }
+    }
+
+    auto glyph_or_error = font_load_glyph(name);
 
-        _fonts[name] = make<Font>(bitmap_or_error.take_value(), glyph_or_error.take_value());
+    if (!glyph_or_error.success())
+    {
+        logger_error("Failed to load font %s: missing glyphs", name.cstring());
+        return glyph_or_error.result();
+    }
+
+    auto bitmap_or_error = font_load_bitmap(name);
+
+    if (!bitmap_or_error.success())
+    {
+        logger_error("Failed to load font %s: missing bitmap", name.cstring());
+        return bitmap_or_error.result();
+    }
+
+    auto glyphs = glyph_or_error.take_value();
+    auto bitmap = bitmap_or_error.take_value();
+
+    // Only the coverage is kept, the RGBA bitmap is dropped once it's computed.
+    auto coverage = font_compute_coverage(*bitmap);
+
+    entry = font_publish_to_cache(name, glyphs, bitmap->width(), bitmap->height(), coverage);
+
+    if (entry)
+    {
+        _fonts[name] = font_create_from_cache_entry(entry);
+    }
+    else
+    {
+        _fonts[name] = make<Font>(bitmap->width(), bitmap->height(), move(coverage), move(glyphs));
     }
 
     return _fonts[name];
 }
 
-Glyph &Font::glyph(Codepoint codepoint)
+Font::Font(int width, int height, const uint8_t *coverage, Vector<Glyph> glyphs)
+    : _width(width),
+      _height(height),
+      _coverage(coverage),
+      _glyphs(move(glyphs))
+{
+    index_glyphs();
+}
+
+Font::Font(int width, int height, Vector<uint8_t> coverage, Vector<Glyph> glyphs)
+    : _width(width),
+      _height(height),
+      _owned_coverage(move(coverage)),
+      _glyphs(move(glyphs))
+{
+    _coverage = _owned_coverage.raw_storage();
+
+    index_glyphs();
+}
+
+void Font::index_glyphs()
 {
-    for (int i = 0; _glyphs[i].codepoint != 0; i++)
+    for (size_t i = 0; i < FONT_DIRECT_MAP_SIZE; i++)
     {
-        if (_glyphs[i].codepoint == codepoint)
+        _direct_map[i] = -1;
+    }
+
+    for (size_t i = 0; i < _glyphs.count() && _glyphs[i].codepoint != 0; i++)
+    {
+        Codepoint codepoint = _glyphs[i].codepoint;
+
+        if (glyph_index(codepoint) != -1)
         {
-            return _glyphs[i];
+            continue;
+        }
+
+        if (codepoint < FONT_DIRECT_MAP_SIZE)
+        {
+            _direct_map[codepoint] = i;
+        }
+        else
+        {
+            _indirect_map[codepoint] = i;
         }
     }
 
-    return _default;
+    _default = glyph(U'?');
 }
 
-bool Font::has_glyph(Codepoint codepoint)
+int Font::glyph_index(Codepoint codepoint)
 {
-    for (int i = 0; _glyphs[i].codepoint != 0; i++)
+    if (codepoint < FONT_DIRECT_MAP_SIZE)
     {
-        if (_glyphs[i].codepoint == codepoint)
-        {
-            return true;
-        }
+        return _direct_map[codepoint];
     }
 
-    return false;
+    if (_indirect_map.has_key(codepoint))
+    {
+        return _indirect_map[codepoint];
+    }
+
+    return -1;
+}
+
+Glyph &Font::glyph(Codepoint codepoint)
+{
+    int index = glyph_index(codepoint);
+
+    if (index == -1)
+    {
+        return _default;
+    }
+
+    return _glyphs[index];
+}
+
+bool Font::has_glyph(Codepoint codepoint)
+{
+    return glyph_index(codepoint) != -1;
 }
 
 Rectangle Font::mesure_string(const char *string)
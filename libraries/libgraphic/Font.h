@@ -2,9 +2,12 @@
 
 #include <libgraphic/Bitmap.h>
 #include <libsystem/unicode/Codepoint.h>
+#include <libutils/HashMap.h>
 #include <libutils/String.h>
 #include <libutils/Vector.h>
 
+#define FONT_DIRECT_MAP_SIZE 256
+
 struct Glyph
 {
     Codepoint codepoint;
@@ -16,21 +19,36 @@ struct Glyph
 class Font : public RefCounted<Font>
 {
 private:
-    RefPtr<Bitmap> _bitmap;
+    int _width;
+    int _height;
+
+    // Points either into a shared font cache entry or into _owned_coverage.
+    const uint8_t *_coverage;
+    Vector<uint8_t> _owned_coverage;
+
     Glyph _default;
     Vector<Glyph> _glyphs;
 
+    // Index in _glyphs of each codepoint, -1 if the font doesn't have it.
+    int _direct_map[FONT_DIRECT_MAP_SIZE];
+    HashMap<Codepoint, int> _indirect_map;
+
+    int glyph_index(Codepoint codepoint);
+
+    void index_glyphs();
+
 public:
-    Bitmap &bitmap() { return *_bitmap; }
+    // One byte of coverage per pixel of the font atlas, so glyphs can be
+    // drawn at 1:1 scale without sampling a bitmap.
+    const uint8_t *coverage() { return _coverage; }
+
+    int coverage_width() { return _width; }
 
     static ResultOr<RefPtr<Font>> create(String name);
 
-    Font(RefPtr<Bitmap> bitmap, Vector<Glyph> glyphs)
-        : _bitmap(bitmap),
-          _glyphs(move(glyphs))
-    {
-        _default = glyph(U'?');
-    }
+    Font(int width, int height, const uint8_t *coverage, Vector<Glyph> glyphs);
+
+    Font(int width, int height, Vector<uint8_t> coverage, Vector<Glyph> glyphs);
 
     Glyph &glyph(Codepoint codepoint);
 
@@ -0,0 +1,117 @@
+#include <libgraphic/FontCache.h>
+#include <libsystem/Logger.h>
+#include <libsystem/core/CString.h>
+#include <libsystem/io/File.h>
+#include <libsystem/io/Filesystem.h>
+#include <libsystem/system/Memory.h>
+
+static void font_cache_entry_path(const char *key, char *path, size_t size)
+{
+    // Keys are often font paths, flatten them to a single file name.
+    snprintf(path, size, "%s/", FONT_CACHE_DIRECTORY);
+
+    size_t length = strlen(path);
+
+    for (size_t i = 0; key[i] && length + 1 < size; i++)
+    {
+        path[length++] = key[i] == '/' ? '.' : key[i];
+    }
+
+    path[length] = '\0';
+}
+
+FontCacheEntry *font_cache_lookup(const char *key)
+{
+    if (strlen(key) >= FONT_CACHE_KEY_SIZE)
+    {
+        return nullptr;
+    }
+
+    char path[PATH_LENGTH];
+    font_cache_entry_path(key, path, PATH_LENGTH);
+
+    int handle = -1;
+    size_t handle_size = 0;
+    void *handle_buffer __cleanup_malloc = nullptr;
+
+    if (file_read_all(path, &handle_buffer, &handle_size) != SUCCESS ||
+        handle_size != sizeof(int))
+    {
+        return nullptr;
+    }
+
+    handle = *reinterpret_cast<int *>(handle_buffer);
+
+    FontCacheEntry *entry = nullptr;
+    size_t size = 0;
+
+    // The process which published the entry may have exited since,
+    // taking the memory with it.
+    if (memory_include(handle, reinterpret_cast<uintptr_t *>(&entry), &size) != SUCCESS)
+    {
+        return nullptr;
+    }
+
+    if (size < sizeof(FontCacheEntry) ||
+        entry->magic != FONT_CACHE_MAGIC ||
+        entry->version != FONT_CACHE_VERSION ||
+        strncmp(entry->key, key, FONT_CACHE_KEY_SIZE) != 0 ||
+        entry->size > size - sizeof(FontCacheEntry))
+    {
+        logger_warn("Stale font cache entry %s", path);
+        font_cache_release(entry);
+        return nullptr;
+    }
+
+    return entry;
+}
+
+FontCacheEntry *font_cache_allocate(size_t size)
+{
+    FontCacheEntry *entry = nullptr;
+
+    if (memory_alloc(sizeof(FontCacheEntry) + size, reinterpret_cast<uintptr_t *>(&entry)) != SUCCESS)
+    {
+        return nullptr;
+    }
+
+    entry->size = size;
+
+    return entry;
+}
+
+void font_cache_publish(const char *key, FontCacheEntry *entry)
+{
+    if (strlen(key) >= FONT_CACHE_KEY_SIZE)
+    {
+        return;
+    }
+
+    int handle = -1;
+
+    if (memory_get_handle(reinterpret_cast<uintptr_t>(entry), &handle) != SUCCESS)
+    {
+        return;
+    }
+
+    entry->version = FONT_CACHE_VERSION;
+    strlcpy(entry->key, key, FONT_CACHE_KEY_SIZE);
+
+    // Only mark the entry valid once it's completely filled.
+    entry->magic = FONT_CACHE_MAGIC;
+
+    if (!filesystem_exist(FONT_CACHE_DIRECTORY, FILE_TYPE_DIRECTORY))
+    {
+        filesystem_mkdir(FONT_CACHE_DIRECTORY);
+    }
+
+    char path[PATH_LENGTH];
+    font_cache_entry_path(key, path, PATH_LENGTH);
+
+    file_write_all(path, &handle, sizeof(handle));
+}
+
+void font_cache_release(FontCacheEntry *entry)
+{
+    memory_free(reinterpret_cast<uintptr_t>(entry));
+}
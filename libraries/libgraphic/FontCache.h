@@ -0,0 +1,40 @@
+#pragma once
+
+#include <abi/Filesystem.h>
+#include <libsystem/Common.h>
+#include <libsystem/Result.h>
+
+// Fonts are shared by all the processes of a session: the first process
+// loading a font copies it into shared memory and publishes the memory
+// handle in FONT_CACHE_DIRECTORY, the others map it instead of reading and
+// decoding the font files again.
+
+#define FONT_CACHE_DIRECTORY "/Session/fonts"
+
+#define FONT_CACHE_MAGIC 0x464f4e54 // FONT
+
+// Bumped whenever the layout of the data changes.
+#define FONT_CACHE_VERSION 2
+
+#define FONT_CACHE_KEY_SIZE PATH_LENGTH
+
+struct FontCacheEntry
+{
+    uint32_t magic;
+    uint32_t version;
+
+    // Published handles outlive the process which published them, and may
+    // be recycled for another entry, so the key is checked on lookup.
+    char key[FONT_CACHE_KEY_SIZE];
+
+    size_t size;
+    uint8_t data[];
+};
+
+FontCacheEntry *font_cache_lookup(const char *key);
+
+FontCacheEntry *font_cache_allocate(size_t size);
+
+void font_cache_publish(const char *key, FontCacheEntry *entry);
+
+void font_cache_release(FontCacheEntry *entry);
@@ -20,6 +20,8 @@ public:
 
     Painter &painter() { return _painter; }
 
+    RefPtr<Bitmap> bitmap() { return _bitmap; }
+
     Rectangle resolution() { return _bitmap->bound(); }
 
     Framebuffer(Handle handle, RefPtr<Bitmap> bitmap);
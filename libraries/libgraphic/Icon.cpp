@@ -13,30 +13,11 @@ const char *_icon_size_names[] = {ICON_SIZE_LIST(ICON_SIZE_NAME_ENTRY)};
 #define ICON_SIZES_ENTRY(__size) __size,
 const int _icon_sizes[] = {ICON_SIZE_LIST(ICON_SIZES_ENTRY)};
 
-static RefPtr<Icon> icon_load(String name)
-{
-    auto icon = make<Icon>(name);
-
-    for (size_t i = 0; i < __ICON_SIZE_COUNT; i++)
-    {
-        char path[PATH_LENGTH] = {};
-        snprintf(path, PATH_LENGTH, "/Files/Icons/%s@%spx.png", name.cstring(), _icon_size_names[i]);
-
-        auto bitmap_or_result = Bitmap::load_from(path);
-        if (bitmap_or_result.success())
-        {
-            icon->set_bitmap(static_cast<IconSize>(i), bitmap_or_result.take_value());
-        }
-    }
-
-    return icon;
-}
-
 RefPtr<Icon> Icon::get(String name)
 {
     if (!_icons.has_key(name))
     {
-        _icons[name] = icon_load(name);
+        _icons[name] = make<Icon>(name);
     }
 
     return _icons[name];
@@ -56,27 +37,50 @@ Rectangle Icon::bound(IconSize size)
     return bitmap(size)->bound();
 }
 
-RefPtr<Bitmap> Icon::bitmap(IconSize size)
+RefPtr<Bitmap> Icon::load(IconSize size)
 {
-    if (!_bitmaps[size])
+    if (!_loaded[size])
     {
-        for (size_t i = 0; i < __ICON_SIZE_COUNT; i++)
+        _loaded[size] = true;
+
+        char path[PATH_LENGTH] = {};
+        snprintf(path, PATH_LENGTH, "/Files/Icons/%s@%spx.png", _name.cstring(), _icon_size_names[size]);
+
+        auto bitmap_or_result = Bitmap::load_from(path);
+
+        if (bitmap_or_result.success())
         {
-            if (_bitmaps[i])
-            {
-                return _bitmaps[i];
-            }
+            _bitmaps[size] = bitmap_or_result.take_value();
         }
-
-        _bitmaps[size] = Bitmap::load_from_or_placeholder("none");
     }
 
     return _bitmaps[size];
+}
+
+RefPtr<Bitmap> Icon::bitmap(IconSize size)
+{
+    if (load(size))
+    {
+        return _bitmaps[size];
+    }
 
-    ASSERT_NOT_REACHED();
+    for (size_t i = 0; i < __ICON_SIZE_COUNT; i++)
+    {
+        auto bitmap = load(static_cast<IconSize>(i));
+
+        if (bitmap)
+        {
+            return bitmap;
+        }
+    }
+
+    _bitmaps[size] = Bitmap::load_from_or_placeholder("none");
+
+    return _bitmaps[size];
 }
 
 void Icon::set_bitmap(IconSize size, RefPtr<Bitmap> bitmap)
 {
+    _loaded[size] = true;
     _bitmaps[size] = bitmap;
 }
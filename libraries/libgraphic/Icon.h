@@ -21,6 +21,11 @@ private:
     String _name;
     RefPtr<Bitmap> _bitmaps[__ICON_SIZE_COUNT] = {};
 
+    // Sizes are only decoded the first time they are asked for.
+    bool _loaded[__ICON_SIZE_COUNT] = {};
+
+    RefPtr<Bitmap> load(IconSize size);
+
 public:
     static RefPtr<Icon> get(String name);
 
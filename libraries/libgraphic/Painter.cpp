@@ -1,7 +1,7 @@
 #include <stdlib.h>
 
+#include <libgraphic/Blur.h>
 #include <libgraphic/Font.h>
-#include <libgraphic/StackBlur.h>
 #include <libsystem/Assert.h>
 #include <libsystem/math/Math.h>
 
@@ -75,6 +75,25 @@ void Painter::plot_pixel(Vec2i position, Color color)
     }
 }
 
+__flatten void Painter::blend_scanline(Vec2i position, const uint8_t *coverage, int width, Color color)
+{
+    Rectangle destination = apply_transform(Rectangle(position, Vec2i(width, 1)));
+    Rectangle clipped_destination = apply_clip(destination);
+
+    if (clipped_destination.is_empty())
+    {
+        return;
+    }
+
+    const uint8_t *coverage_row = &coverage[clipped_destination.x() - destination.x()];
+    Color *destination_row = &_bitmap->pixels()[clipped_destination.y() * _bitmap->width() + clipped_destination.x()];
+
+    for (int x = 0; x < clipped_destination.width(); x++)
+    {
+        destination_row[x] = Color::blend(color, destination_row[x], coverage_row[x]);
+    }
+}
+
 void Painter::blit_bitmap_fast(Bitmap &bitmap, Rectangle source, Rectangle destination)
 {
     Rectangle clipped_destination = apply_transform(destination);
@@ -144,6 +163,22 @@ void Painter::blit_bitmap_fast_no_alpha(Bitmap &bitmap, Rectangle source, Rectan
     if (clipped_destination.is_empty())
         return;
 
+    if (bitmap.bound().contains(clipped_source))
+    {
+        for (int y = 0; y < clipped_destination.height(); y++)
+        {
+            Color *source_row = &bitmap.pixels()[(clipped_source.y() + y) * bitmap.width() + clipped_source.x()];
+            Color *destination_row = &_bitmap->pixels()[(clipped_destination.y() + y) * _bitmap->width() + clipped_destination.x()];
+
+            for (int x = 0; x < clipped_destination.width(); x++)
+            {
+                destination_row[x] = source_row[x].with_alpha(1);
+            }
+        }
+
+        return;
+    }
+
     for (int x = 0; x < clipped_destination.width(); x++)
     {
         for (int y = 0; y < clipped_destination.height(); y++)
@@ -641,38 +676,34 @@ __flatten void Painter::blur_rectangle(Rectangle rectangle, int radius)
     rectangle = apply_transform(rectangle);
     rectangle = apply_clip(rectangle);
 
-    stackblurJob((unsigned char *)_bitmap->pixels(),
-                 _bitmap->width(),
-                 _bitmap->height(),
-                 radius,
-                 rectangle.x(), rectangle.x() + rectangle.width(),
-                 rectangle.y(), rectangle.y() + rectangle.height());
+    blur_bitmap(*_bitmap, rectangle, radius);
 }
 
-__flatten void Painter::blit_bitmap_colored(Bitmap &bitmap, Rectangle source, Rectangle destination, Color color)
+__flatten void Painter::draw_glyph(Font &font, Glyph &glyph, Vec2i position, Color color)
 {
-    for (int x = 0; x < destination.width(); x++)
+    Rectangle destination = apply_transform(Rectangle(position - glyph.origin, glyph.bound.size()));
+    Rectangle clipped_destination = apply_clip(destination);
+
+    if (clipped_destination.is_empty())
     {
-        for (int y = 0; y < destination.height(); y++)
-        {
-            Vec2f sample_point(
-                x / (double)destination.width(),
-                y / (double)destination.height());
+        return;
+    }
 
-            Color sample = bitmap.sample(source, sample_point);
+    int coverage_width = font.coverage_width();
+    Vec2i source = glyph.bound.position() + clipped_destination.position() - destination.position();
 
-            auto alpha = sample.redf() * color.alphaf();
-            plot_pixel(destination.position() + Vec2i(x, y), color.with_alpha(alpha));
+    for (int y = 0; y < clipped_destination.height(); y++)
+    {
+        const uint8_t *coverage_row = &font.coverage()[(source.y() + y) * coverage_width + source.x()];
+        Color *destination_row = &_bitmap->pixels()[(clipped_destination.y() + y) * _bitmap->width() + clipped_destination.x()];
+
+        for (int x = 0; x < clipped_destination.width(); x++)
+        {
+            destination_row[x] = Color::blend(color, destination_row[x], coverage_row[x]);
         }
     }
 }
 
-void Painter::draw_glyph(Font &font, Glyph &glyph, Vec2i position, Color color)
-{
-    Rectangle dest(position - glyph.origin, glyph.bound.size());
-    blit_bitmap_colored(font.bitmap(), glyph.bound, dest, color);
-}
-
 __flatten void Painter::draw_string(Font &font, const char *str, Vec2i position, Color color)
 {
     codepoint_foreach(reinterpret_cast<const uint8_t *>(str), [&](auto codepoint) {
@@ -691,24 +722,29 @@ void Painter::draw_string_within(Font &font, const char *str, Rectangle containe
     draw_string(font, str, Vec2i(bound.x(), bound.y() + bound.height() / 2 + 4), color);
 }
 
-void Painter::draw_truetype_glyph(TrueTypeFont *font, TrueTypeGlyph *glyph, Vec2i position, Color color)
+__flatten void Painter::draw_truetype_glyph(TrueTypeFont *font, TrueTypeGlyph *glyph, Vec2i position, Color color)
 {
-    Rectangle dest(position + glyph->offset, glyph->bound.size());
-    TrueTypeAtlas *atlas = truetypefont_get_atlas(font);
+    Rectangle destination = apply_transform(Rectangle(position + glyph->offset, glyph->bound.size()));
+    Rectangle clipped_destination = apply_clip(destination);
 
-    for (int x = 0; x < dest.width(); x++)
+    if (clipped_destination.is_empty())
     {
-        for (int y = 0; y < dest.height(); y++)
-        {
-            int pixel_index = (y + glyph->bound.y()) * atlas->width + (x + glyph->bound.x());
+        return;
+    }
+
+    TrueTypeAtlas *atlas = truetypefont_get_atlas(font, glyph);
+    Vec2i source = glyph->bound.position() + clipped_destination.position() - destination.position();
 
-            auto alpha = (atlas->buffer[pixel_index] / 255.0) * color.alphaf();
+    for (int y = 0; y < clipped_destination.height(); y++)
+    {
+        const uint8_t *coverage_row = &atlas->buffer[(source.y() + y) * atlas->width + source.x()];
+        Color *destination_row = &_bitmap->pixels()[(clipped_destination.y() + y) * _bitmap->width() + clipped_destination.x()];
 
-            plot_pixel(dest.position() + Vec2i(x, y), color.with_alpha(alpha));
+        for (int x = 0; x < clipped_destination.width(); x++)
+        {
+            destination_row[x] = Color::blend(color, destination_row[x], coverage_row[x]);
         }
     }
-
-    //draw_rectangle( dest, COLOR_RED);
 }
 
 #include <libsystem/Logger.h>
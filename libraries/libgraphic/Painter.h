@@ -35,6 +35,8 @@ public:
 
     void plot_pixel(Vec2i position, Color color);
 
+    void blend_scanline(Vec2i position, const uint8_t *coverage, int width, Color color);
+
     void blit_bitmap(Bitmap &bitmap, Rectangle source, Rectangle destination);
 
     void blit_bitmap_no_alpha(Bitmap &bitmap, Rectangle source, Rectangle destination);
@@ -104,7 +106,5 @@ private:
 
     void draw_line_not_aligned(Vec2i a, Vec2i b, Color color);
 
-    void blit_bitmap_colored(Bitmap &src, Rectangle src_rect, Rectangle dst_rect, Color color);
-
     void draw_circle_helper(Rectangle bound, Vec2i center, int radius, int thickness, Color color);
 };
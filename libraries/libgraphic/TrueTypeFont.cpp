@@ -1,161 +1,343 @@
 #include <libgraphic/Bitmap.h>
+#include <libgraphic/FontCache.h>
 #include <libgraphic/TrueType.h>
 #include <libgraphic/TrueTypeFont.h>
 #include <libsystem/algebra/Vec2.h>
 #include <libsystem/io/Stream.h>
+#include <libutils/HashMap.h>
+#include <libutils/String.h>
+#include <libutils/Vector.h>
+
+#define TRUETYPE_ATLAS_PAGE_SIZE 256
+#define TRUETYPE_ATLAS_MAX_PAGES 16
+#define TRUETYPE_DIRECT_MAP_SIZE 256
 
 struct TrueTypeFamily
 {
+    String path;
+    int refcount;
+
     truetype::File info;
     void *buffer;
     size_t buffer_size;
+
+    // Set when the buffer is mapped from the session font cache.
+    FontCacheEntry *entry;
+
+    Vector<TrueTypeFont *> fonts;
 };
 
-struct TrueTypeFont
+struct TrueTypeAtlasPage
 {
-    truetype_pack_context rasterizer;
+    truetype_pack_context packer;
+    TrueTypeAtlas *atlas;
+    uint last_used;
+};
 
+struct TrueTypeFont
+{
     TrueTypeFamily *family;
     int size;
+    int refcount;
 
-    size_t glyphs_count;
-    TrueTypeGlyph *glyphs;
-    TrueTypeAtlas *atlas;
+    Vector<TrueTypeGlyph> glyphs;
+
+    // Index + 1 in glyphs of the first codepoints, zero if never looked up.
+    size_t direct_map[TRUETYPE_DIRECT_MAP_SIZE];
+    HashMap<Codepoint, size_t> indirect_map;
+
+    Vector<TrueTypeAtlasPage> pages;
+    // The page glyphs are packed into, the last one allocated or recycled.
+    size_t current_page;
+    uint clock;
+    size_t evictions;
 };
 
+// Families and fonts are shared by every window of the process, so a font
+// size is only rasterized once no matter how many widgets are using it.
+static Vector<TrueTypeFamily *> _families;
+
 TrueTypeFamily *truetype_family_create(const char *path)
 {
-    Stream *font_file = stream_open(path, OPEN_READ);
+    for (size_t i = 0; i < _families.count(); i++)
+    {
+        if (_families[i]->path == path)
+        {
+            _families[i]->refcount++;
+            return _families[i];
+        }
+    }
+
+    TrueTypeFamily *family = new TrueTypeFamily();
+    family->path = path;
+    family->refcount = 1;
+    family->entry = font_cache_lookup(path);
+
+    if (!family->entry)
+    {
+        Stream *font_file = stream_open(path, OPEN_READ);
 
-    FileState state = {};
-    stream_stat(font_file, &state);
+        FileState state = {};
+        stream_stat(font_file, &state);
 
-    TrueTypeFamily *family = __create(TrueTypeFamily);
-    family->buffer_size = state.size;
-    family->buffer = malloc(state.size);
+        family->entry = font_cache_allocate(state.size);
 
-    stream_read(font_file, family->buffer, state.size);
+        if (family->entry)
+        {
+            stream_read(font_file, family->entry->data, state.size);
+            font_cache_publish(path, family->entry);
+        }
+        else
+        {
+            family->buffer = malloc(state.size);
+            stream_read(font_file, family->buffer, state.size);
+        }
+
+        family->buffer_size = state.size;
+
+        stream_close(font_file);
+    }
+
+    if (family->entry)
+    {
+        family->buffer = family->entry->data;
+        family->buffer_size = family->entry->size;
+    }
 
     truetype_InitFont(&family->info, (unsigned char *)family->buffer);
 
+    _families.push_back(family);
+
     return family;
 }
 
 void truetype_family_destroy(TrueTypeFamily *family)
 {
-    free(family->buffer);
-    free(family);
+    family->refcount--;
+
+    if (family->refcount > 0)
+    {
+        return;
+    }
+
+    _families.remove_value(family);
+
+    if (family->entry)
+    {
+        font_cache_release(family->entry);
+    }
+    else
+    {
+        free(family->buffer);
+    }
+
+    delete family;
 }
 
 TrueTypeFont *truetypefont_create(TrueTypeFamily *family, int size)
 {
-    TrueTypeFont *font = __create(TrueTypeFont);
+    for (size_t i = 0; i < family->fonts.count(); i++)
+    {
+        if (family->fonts[i]->size == size)
+        {
+            family->fonts[i]->refcount++;
+            return family->fonts[i];
+        }
+    }
+
+    TrueTypeFont *font = new TrueTypeFont();
 
     font->family = family;
     font->size = size;
+    font->refcount = 1;
 
-    TrueTypeAtlas *atlas = (TrueTypeAtlas *)malloc(sizeof(TrueTypeAtlas) + 512 * 512);
-    atlas->width = 512;
-    atlas->height = 512;
-
-    font->atlas = atlas;
-
-    truetype_PackBegin(
-        &font->rasterizer,
-        atlas->buffer,
-        atlas->width,
-        atlas->height,
-        0,
-        1);
-
-    //truetypefont_raster_range(font, 0x0020, 0x007f);
-    //truetypefont_raster_range(font, 0x00A0, 0x00FF);
+    family->refcount++;
+    family->fonts.push_back(font);
 
     return font;
 }
 
 void truetypefont_destroy(TrueTypeFont *font)
 {
-    truetype_PackEnd(&font->rasterizer);
+    font->refcount--;
 
-    if (font->glyphs)
+    if (font->refcount > 0)
     {
-        free(font->glyphs);
+        return;
     }
 
-    free(font->atlas);
-    free(font);
+    for (size_t i = 0; i < font->pages.count(); i++)
+    {
+        truetype_PackEnd(&font->pages[i].packer);
+        free(font->pages[i].atlas);
+    }
+
+    font->family->fonts.remove_value(font);
+    truetype_family_destroy(font->family);
+
+    delete font;
 }
 
-void truetypefont_raster_range(TrueTypeFont *font, Codepoint start, Codepoint end)
+static TrueTypeAtlasPage *truetypefont_allocate_page(TrueTypeFont *font)
 {
-    size_t start_index = 0;
-    size_t count = end - start + 1;
-
-    if (!font->glyphs)
+    if (font->pages.count() < TRUETYPE_ATLAS_MAX_PAGES)
     {
-        font->glyphs_count = count;
-        font->glyphs = (TrueTypeGlyph *)calloc(font->glyphs_count, sizeof(TrueTypeGlyph));
+        TrueTypeAtlas *atlas = (TrueTypeAtlas *)malloc(sizeof(TrueTypeAtlas) + TRUETYPE_ATLAS_PAGE_SIZE * TRUETYPE_ATLAS_PAGE_SIZE);
+        atlas->width = TRUETYPE_ATLAS_PAGE_SIZE;
+        atlas->height = TRUETYPE_ATLAS_PAGE_SIZE;
+
+        TrueTypeAtlasPage page = {};
+        page.atlas = atlas;
+        truetype_PackBegin(&page.packer, atlas->buffer, atlas->width, atlas->height, 0, 1);
+
+        font->current_page = font->pages.count();
+        return &font->pages.push_back(page);
     }
-    else
+
+    size_t least_recently_used = 0;
+
+    for (size_t i = 1; i < font->pages.count(); i++)
     {
-        start_index = font->glyphs_count;
+        if (font->pages[i].last_used < font->pages[least_recently_used].last_used)
+        {
+            least_recently_used = i;
+        }
+    }
 
-        font->glyphs_count += count;
-        font->glyphs = (TrueTypeGlyph *)realloc(font->glyphs, font->glyphs_count * sizeof(TrueTypeGlyph));
+    for (size_t i = 0; i < font->glyphs.count(); i++)
+    {
+        if (font->glyphs[i].page == (int)least_recently_used)
+        {
+            font->glyphs[i].page = -1;
+        }
     }
 
-    __cleanup_malloc truetype_packedchar *packedchar = (truetype_packedchar *)calloc(0x02AF, sizeof(truetype_packedchar));
-    truetype_PackFontRange(&font->rasterizer, (unsigned char *)font->family->buffer, font->size, start, count, packedchar);
+    TrueTypeAtlasPage *page = &font->pages[least_recently_used];
+
+    truetype_PackEnd(&page->packer);
+    truetype_PackBegin(&page->packer, page->atlas->buffer, page->atlas->width, page->atlas->height, 0, 1);
+
+    font->evictions++;
+    font->current_page = least_recently_used;
 
-    for (size_t i = 0; i < count; i++)
+    return page;
+}
+
+static bool truetypefont_raster_glyph_in_page(TrueTypeFont *font, TrueTypeGlyph *glyph, TrueTypeAtlasPage *page)
+{
+    truetype_packedchar packedchar = {};
+
+    if (!truetype_PackFontRange(&page->packer, (unsigned char *)font->family->buffer, font->size, glyph->codepoint, 1, &packedchar))
     {
-        TrueTypeGlyph *glyph = &font->glyphs[start_index + i];
+        return false;
+    }
+
+    glyph->advance = packedchar.xadvance;
+    glyph->offset = Vec2i(packedchar.xoff, packedchar.yoff);
+
+    glyph->bound = Rectangle(
+        packedchar.x0,
+        packedchar.y0,
+        packedchar.x1 - packedchar.x0,
+        packedchar.y1 - packedchar.y0);
 
-        glyph->advance = packedchar[i].xadvance;
+    glyph->page = page - &font->pages[0];
+    page->last_used = font->clock;
 
-        glyph->offset = Vec2i(packedchar[i].xoff, packedchar[i].yoff);
+    return true;
+}
+
+static void truetypefont_raster_glyph(TrueTypeFont *font, TrueTypeGlyph *glyph)
+{
+    // Glyphs are packed in the most recently allocated or recycled page
+    // until it is full, then a new page is allocated or the least recently
+    // used one is recycled.
+    if (font->pages.any() && truetypefont_raster_glyph_in_page(font, glyph, &font->pages[font->current_page]))
+    {
+        return;
+    }
 
-        glyph->codepoint = start + i;
+    TrueTypeAtlasPage *page = truetypefont_allocate_page(font);
 
-        glyph->bound = Rectangle(
-            packedchar[i].x0,
-            packedchar[i].y0,
-            packedchar[i].x1 - packedchar[i].x0,
-            packedchar[i].y1 - packedchar[i].y0);
+    if (!truetypefont_raster_glyph_in_page(font, glyph, page))
+    {
+        // The glyph is bigger than an atlas page.
+        glyph->bound = Rectangle::empty();
+        glyph->page = -1;
     }
 }
 
-TrueTypeAtlas *truetypefont_get_atlas(TrueTypeFont *font)
+static TrueTypeGlyph *truetypefont_lookup_glyph(TrueTypeFont *font, Codepoint codepoint)
 {
-    return font->atlas;
+    size_t index = 0;
+
+    if (codepoint < TRUETYPE_DIRECT_MAP_SIZE)
+    {
+        index = font->direct_map[codepoint];
+    }
+    else if (font->indirect_map.has_key(codepoint))
+    {
+        index = font->indirect_map[codepoint];
+    }
+
+    if (index)
+    {
+        return &font->glyphs[index - 1];
+    }
+
+    TrueTypeGlyph glyph = {};
+    glyph.codepoint = codepoint;
+    glyph.page = -1;
+
+    font->glyphs.push_back(glyph);
+    index = font->glyphs.count();
+
+    if (codepoint < TRUETYPE_DIRECT_MAP_SIZE)
+    {
+        font->direct_map[codepoint] = index;
+    }
+    else
+    {
+        font->indirect_map[codepoint] = index;
+    }
+
+    TrueTypeGlyph *new_glyph = &font->glyphs[index - 1];
+    truetypefont_raster_glyph(font, new_glyph);
+
+    return new_glyph;
 }
 
-static TrueTypeGlyph *lookup_glyph(TrueTypeFont *font, Codepoint codepoint)
+void truetypefont_raster_range(TrueTypeFont *font, Codepoint start, Codepoint end)
 {
-    for (size_t i = 0; i < font->glyphs_count; i++)
+    for (Codepoint codepoint = start; codepoint <= end; codepoint++)
     {
-        if (font->glyphs[i].codepoint == codepoint)
-        {
-            return &font->glyphs[i];
-        }
+        truetypefont_get_glyph_for_codepoint(font, codepoint);
     }
+}
+
+TrueTypeAtlas *truetypefont_get_atlas(TrueTypeFont *font, TrueTypeGlyph *glyph)
+{
+    assert(glyph->page >= 0);
 
-    return nullptr;
+    return font->pages[glyph->page].atlas;
 }
 
 TrueTypeGlyph *truetypefont_get_glyph_for_codepoint(TrueTypeFont *font, Codepoint codepoint)
 {
-    TrueTypeGlyph *glyph = lookup_glyph(font, codepoint);
+    font->clock++;
 
-    if (glyph != nullptr)
+    TrueTypeGlyph *glyph = truetypefont_lookup_glyph(font, codepoint);
+
+    if (glyph->page == -1 && !glyph->bound.is_empty())
     {
-        return glyph;
+        truetypefont_raster_glyph(font, glyph);
+    }
+    else if (glyph->page != -1)
+    {
+        font->pages[glyph->page].last_used = font->clock;
     }
 
-    truetypefont_raster_range(font, codepoint, codepoint);
-
-    return lookup_glyph(font, codepoint);
+    return glyph;
 }
 
 Rectangle truetypefont_mesure_string(TrueTypeFont *font, const char *string)
@@ -168,7 +350,8 @@ Rectangle truetypefont_mesure_string(TrueTypeFont *font, const char *string)
     string += size;
     while (size && codepoint != 0)
     {
-        TrueTypeGlyph *glyph = truetypefont_get_glyph_for_codepoint(font, codepoint);
+        // Evicted glyphs keep their metrics, no need to rasterize them again.
+        TrueTypeGlyph *glyph = truetypefont_lookup_glyph(font, codepoint);
 
         width += glyph->advance;
 
@@ -209,3 +392,25 @@ TrueTypeFontMetrics truetypefont_get_metrics(TrueTypeFont *font)
 
     return metrics;
 }
+
+TrueTypeFontStats truetypefont_get_stats(TrueTypeFont *font)
+{
+    TrueTypeFontStats stats = {};
+
+    stats.glyphs = font->glyphs.count();
+
+    for (size_t i = 0; i < font->glyphs.count(); i++)
+    {
+        if (font->glyphs[i].page != -1)
+        {
+            stats.rasterized_glyphs++;
+        }
+    }
+
+    stats.pages = font->pages.count();
+    stats.memory = font->pages.count() * (sizeof(TrueTypeAtlas) + TRUETYPE_ATLAS_PAGE_SIZE * TRUETYPE_ATLAS_PAGE_SIZE) +
+                   font->glyphs.count() * sizeof(TrueTypeGlyph);
+    stats.evictions = font->evictions;
+
+    return stats;
+}
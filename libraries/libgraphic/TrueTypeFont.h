@@ -20,6 +20,18 @@ struct TrueTypeGlyph
     Rectangle bound;
     Vec2i offset;
     int advance;
+
+    // Atlas page holding the glyph, -1 if it was evicted.
+    int page;
+};
+
+struct TrueTypeFontStats
+{
+    size_t glyphs;
+    size_t rasterized_glyphs;
+    size_t pages;
+    size_t memory;
+    size_t evictions;
 };
 
 struct TrueTypeAtlas
@@ -35,9 +47,11 @@ void truetype_family_destroy(TrueTypeFamily *family);
 
 TrueTypeFont *truetypefont_create(TrueTypeFamily *family, int size);
 
+void truetypefont_destroy(TrueTypeFont *font);
+
 void truetypefont_raster_range(TrueTypeFont *font, Codepoint start, Codepoint end);
 
-TrueTypeAtlas *truetypefont_get_atlas(TrueTypeFont *font);
+TrueTypeAtlas *truetypefont_get_atlas(TrueTypeFont *font, TrueTypeGlyph *glyph);
 
 TrueTypeGlyph *truetypefont_get_glyph_for_codepoint(TrueTypeFont *font, Codepoint codepoint);
 
@@ -46,3 +60,5 @@ Rectangle truetypefont_mesure_string(TrueTypeFont *font, const char *string);
 int truetypefont_get_kerning_for_codepoints(TrueTypeFont *font, Codepoint left, Codepoint right);
 
 TrueTypeFontMetrics truetypefont_get_metrics(TrueTypeFont *font);
+
+TrueTypeFontStats truetypefont_get_stats(TrueTypeFont *font);
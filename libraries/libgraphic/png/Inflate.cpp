@@ -0,0 +1,409 @@
+#include <libgraphic/png/Inflate.h>
+#include <libsystem/core/CString.h>
+#include <libsystem/math/MinMax.h>
+
+static const uint16_t _length_base[] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+
+static const uint8_t _length_extra[] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+
+static const uint16_t _distance_base[] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+
+static const uint8_t _distance_extra[] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+static const uint8_t _code_lengths_order[] = {
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+Inflate::Inflate(Callback<size_t(uint8_t *buffer, size_t size)> source)
+    : _source(source)
+{
+}
+
+bool Inflate::refill()
+{
+    if (_input_position < _input_size)
+    {
+        return true;
+    }
+
+    _input_position = 0;
+    _input_size = _source(_input, INFLATE_INPUT_SIZE);
+
+    return _input_size > 0;
+}
+
+void Inflate::fill_bits(int count)
+{
+    // Doesn't fail at the end of the input, the decoder only peeks at these bits.
+    while (_bits_count < count && refill())
+    {
+        _bits |= (uint32_t)_input[_input_position++] << _bits_count;
+        _bits_count += 8;
+    }
+}
+
+uint32_t Inflate::bits(int count)
+{
+    fill_bits(count);
+
+    if (_bits_count < count)
+    {
+        _result = ERR_BAD_IMAGE_FILE_FORMAT;
+        return 0;
+    }
+
+    uint32_t value = _bits & ((1u << count) - 1);
+
+    _bits >>= count;
+    _bits_count -= count;
+
+    return value;
+}
+
+void Inflate::build(InflateHuffman &huffman, const uint8_t *lengths, int count)
+{
+    memset(&huffman, 0, sizeof(InflateHuffman));
+
+    for (int i = 0; i < count; i++)
+    {
+        huffman.count[lengths[i]]++;
+    }
+
+    huffman.count[0] = 0;
+
+    uint16_t offsets[INFLATE_MAX_BITS + 2] = {};
+
+    for (int length = 1; length <= INFLATE_MAX_BITS; length++)
+    {
+        offsets[length + 1] = offsets[length] + huffman.count[length];
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        if (lengths[i])
+        {
+            huffman.symbol[offsets[lengths[i]]++] = i;
+        }
+    }
+
+    // Codes are packed starting from their most significant bit, so they
+    // are reversed to index the fast table with the bits as they come.
+    int code = 0;
+    int index = 0;
+
+    for (int length = 1; length <= INFLATE_FAST_BITS; length++)
+    {
+        for (int i = 0; i < huffman.count[length]; i++, code++, index++)
+        {
+            int reversed = 0;
+
+            for (int bit = 0; bit < length; bit++)
+            {
+                reversed |= ((code >> bit) & 1) << (length - bit - 1);
+            }
+
+            for (int entry = reversed; entry < (1 << INFLATE_FAST_BITS); entry += 1 << length)
+            {
+                huffman.fast[entry] = (huffman.symbol[index] << 4) | length;
+            }
+        }
+
+        code <<= 1;
+    }
+}
+
+int Inflate::decode(InflateHuffman &huffman)
+{
+    fill_bits(INFLATE_FAST_BITS);
+
+    uint16_t entry = huffman.fast[_bits & ((1 << INFLATE_FAST_BITS) - 1)];
+    int length = entry & 0xf;
+
+    if (entry && length <= _bits_count)
+    {
+        _bits >>= length;
+        _bits_count -= length;
+
+        return entry >> 4;
+    }
+
+    // Slow path for the longer codes, one bit at the time.
+    int code = 0;
+    int first = 0;
+    int index = 0;
+
+    for (length = 1; length <= INFLATE_MAX_BITS; length++)
+    {
+        code |= bits(1);
+
+        int count = huffman.count[length];
+
+        if (code - count < first)
+        {
+            return huffman.symbol[index + (code - first)];
+        }
+
+        index += count;
+        first += count;
+        first <<= 1;
+        code <<= 1;
+    }
+
+    _result = ERR_BAD_IMAGE_FILE_FORMAT;
+    return 0;
+}
+
+void Inflate::read_zlib_header()
+{
+    uint32_t method = bits(8);
+    uint32_t flags = bits(8);
+
+    if ((method & 0xf) != 8 || ((method << 8) | flags) % 31 != 0 || (flags & 0x20))
+    {
+        _result = ERR_BAD_IMAGE_FILE_FORMAT;
+        return;
+    }
+
+    _state = State::BLOCK_HEADER;
+}
+
+void Inflate::read_dynamic_tables()
+{
+    int literals_count = bits(5) + 257;
+    int distances_count = bits(5) + 1;
+    int code_lengths_count = bits(4) + 4;
+
+    // The header can declare up to 288 literals and 32 distances, but
+    // only 286 and 30 of them exist.
+    if (literals_count > 286 || distances_count > 30)
+    {
+        _result = ERR_BAD_IMAGE_FILE_FORMAT;
+        return;
+    }
+
+    uint8_t lengths[286 + 30] = {};
+
+    for (int i = 0; i < code_lengths_count; i++)
+    {
+        lengths[_code_lengths_order[i]] = bits(3);
+    }
+
+    build(_literals, lengths, 19);
+    memset(lengths, 0, sizeof(lengths));
+
+    int index = 0;
+
+    while (index < literals_count + distances_count && _result == SUCCESS)
+    {
+        int symbol = decode(_literals);
+
+        if (symbol < 16)
+        {
+            lengths[index++] = symbol;
+            continue;
+        }
+
+        int repeat = 0;
+        uint8_t value = 0;
+
+        if (symbol == 16)
+        {
+            if (index == 0)
+            {
+                _result = ERR_BAD_IMAGE_FILE_FORMAT;
+                return;
+            }
+
+            value = lengths[index - 1];
+            repeat = 3 + bits(2);
+        }
+        else if (symbol == 17)
+        {
+            repeat = 3 + bits(3);
+        }
+        else
+        {
+            repeat = 11 + bits(7);
+        }
+
+        if (index + repeat > literals_count + distances_count)
+        {
+            _result = ERR_BAD_IMAGE_FILE_FORMAT;
+            return;
+        }
+
+        while (repeat--)
+        {
+            lengths[index++] = value;
+        }
+    }
+
+    build(_literals, lengths, literals_count);
+    build(_distances, lengths + literals_count, distances_count);
+}
+
+void Inflate::read_block_header()
+{
+    if (_final)
+    {
+        _state = State::DONE;
+        return;
+    }
+
+    _final = bits(1);
+    uint32_t type = bits(2);
+
+    if (type == 0)
+    {
+        _bits >>= _bits_count % 8;
+        _bits_count -= _bits_count % 8;
+
+        uint32_t length = bits(16);
+        uint32_t complement = bits(16);
+
+        if ((length ^ 0xffff) != complement)
+        {
+            _result = ERR_BAD_IMAGE_FILE_FORMAT;
+            return;
+        }
+
+        _stored_remaining = length;
+        _state = State::STORED;
+    }
+    else if (type == 1)
+    {
+        uint8_t lengths[288 + 30];
+
+        memset(lengths, 8, 144);
+        memset(lengths + 144, 9, 112);
+        memset(lengths + 256, 7, 24);
+        memset(lengths + 280, 8, 8);
+        memset(lengths + 288, 5, 30);
+
+        build(_literals, lengths, 288);
+        build(_distances, lengths + 288, 30);
+
+        _state = State::HUFFMAN;
+    }
+    else if (type == 2)
+    {
+        read_dynamic_tables();
+        _state = State::HUFFMAN;
+    }
+    else
+    {
+        _result = ERR_BAD_IMAGE_FILE_FORMAT;
+    }
+}
+
+void Inflate::read_length_and_distance(int symbol)
+{
+    symbol -= 257;
+
+    if (symbol >= 29)
+    {
+        _result = ERR_BAD_IMAGE_FILE_FORMAT;
+        return;
+    }
+
+    int length = _length_base[symbol] + bits(_length_extra[symbol]);
+
+    int distance_symbol = decode(_distances);
+
+    if (distance_symbol >= 30)
+    {
+        _result = ERR_BAD_IMAGE_FILE_FORMAT;
+        return;
+    }
+
+    int distance = _distance_base[distance_symbol] + bits(_distance_extra[distance_symbol]);
+
+    if ((size_t)distance > _window_used)
+    {
+        _result = ERR_BAD_IMAGE_FILE_FORMAT;
+        return;
+    }
+
+    _copy_length = length;
+    _copy_distance = distance;
+}
+
+Result Inflate::read(uint8_t *buffer, size_t size)
+{
+    size_t produced = 0;
+
+    auto emit = [&](uint8_t byte) {
+        buffer[produced++] = byte;
+
+        _window[_window_position] = byte;
+        _window_position = (_window_position + 1) & (INFLATE_WINDOW_SIZE - 1);
+        _window_used = MIN(_window_used + 1, INFLATE_WINDOW_SIZE);
+    };
+
+    while (produced < size && _result == SUCCESS)
+    {
+        if (_copy_length > 0)
+        {
+            emit(_window[(_window_position - _copy_distance) & (INFLATE_WINDOW_SIZE - 1)]);
+            _copy_length--;
+
+            continue;
+        }
+
+        switch (_state)
+        {
+        case State::ZLIB_HEADER:
+            read_zlib_header();
+            break;
+
+        case State::BLOCK_HEADER:
+            read_block_header();
+            break;
+
+        case State::STORED:
+            if (_stored_remaining == 0)
+            {
+                _state = State::BLOCK_HEADER;
+            }
+            else
+            {
+                emit(bits(8));
+                _stored_remaining--;
+            }
+            break;
+
+        case State::HUFFMAN:
+        {
+            int symbol = decode(_literals);
+
+            if (symbol < 256)
+            {
+                emit(symbol);
+            }
+            else if (symbol == 256)
+            {
+                _state = State::BLOCK_HEADER;
+            }
+            else
+            {
+                read_length_and_distance(symbol);
+            }
+
+            break;
+        }
+
+        case State::DONE:
+            _result = ERR_BAD_IMAGE_FILE_FORMAT;
+            break;
+        }
+    }
+
+    return _result;
+}
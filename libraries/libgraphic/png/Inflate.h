@@ -0,0 +1,85 @@
+#pragma once
+
+#include <libsystem/Common.h>
+#include <libsystem/Result.h>
+#include <libutils/Callback.h>
+
+#define INFLATE_WINDOW_SIZE 32768
+#define INFLATE_INPUT_SIZE 4096
+#define INFLATE_FAST_BITS 9
+#define INFLATE_MAX_BITS 15
+
+struct InflateHuffman
+{
+    // (symbol << 4) | length for codes of at most INFLATE_FAST_BITS bits, zero otherwise.
+    uint16_t fast[1 << INFLATE_FAST_BITS];
+
+    uint16_t count[INFLATE_MAX_BITS + 1];
+    uint16_t symbol[288];
+};
+
+// Streaming zlib/DEFLATE decoder: compressed bytes are pulled from the
+// source callback as they are needed and decompressed bytes are produced
+// on demand, so the memory used is bounded by the 32KiB history window no
+// matter how large the stream is.
+class Inflate
+{
+private:
+    enum class State
+    {
+        ZLIB_HEADER,
+        BLOCK_HEADER,
+        STORED,
+        HUFFMAN,
+        DONE,
+    };
+
+    Callback<size_t(uint8_t *buffer, size_t size)> _source;
+    Result _result = SUCCESS;
+
+    uint8_t _input[INFLATE_INPUT_SIZE];
+    size_t _input_position = 0;
+    size_t _input_size = 0;
+
+    uint32_t _bits = 0;
+    int _bits_count = 0;
+
+    uint8_t _window[INFLATE_WINDOW_SIZE];
+    size_t _window_position = 0;
+    size_t _window_used = 0;
+
+    State _state = State::ZLIB_HEADER;
+    bool _final = false;
+    size_t _stored_remaining = 0;
+    int _copy_length = 0;
+    int _copy_distance = 0;
+
+    InflateHuffman _literals;
+    InflateHuffman _distances;
+
+    bool refill();
+
+    void fill_bits(int count);
+
+    uint32_t bits(int count);
+
+    int decode(InflateHuffman &huffman);
+
+    void build(InflateHuffman &huffman, const uint8_t *lengths, int count);
+
+    void read_zlib_header();
+
+    void read_block_header();
+
+    void read_dynamic_tables();
+
+    void read_length_and_distance(int symbol);
+
+public:
+    Result result() { return _result; }
+
+    Inflate(Callback<size_t(uint8_t *buffer, size_t size)> source);
+
+    // Produce exactly size decompressed bytes, or fail.
+    Result read(uint8_t *buffer, size_t size);
+};
@@ -0,0 +1,561 @@
+#include <libgraphic/png/PNGDecoder.h>
+#include <libsystem/core/CString.h>
+#include <libsystem/math/MinMax.h>
+
+#define PNG_COLOR_GRAY 0
+#define PNG_COLOR_RGB 2
+#define PNG_COLOR_PALETTE 3
+#define PNG_COLOR_GRAY_ALPHA 4
+#define PNG_COLOR_RGBA 6
+
+// Keeps the row and bitmap sizes well within size_t.
+#define PNG_MAX_SIZE 16384
+
+#define PNG_FILTER_NONE 0
+#define PNG_FILTER_SUB 1
+#define PNG_FILTER_UP 2
+#define PNG_FILTER_AVERAGE 3
+#define PNG_FILTER_PAETH 4
+
+static const uint8_t _png_signature[] = {137, 80, 78, 71, 13, 10, 26, 10};
+
+static int png_channels(int color_type)
+{
+    switch (color_type)
+    {
+    case PNG_COLOR_GRAY:
+    case PNG_COLOR_PALETTE:
+        return 1;
+
+    case PNG_COLOR_GRAY_ALPHA:
+        return 2;
+
+    case PNG_COLOR_RGB:
+        return 3;
+
+    case PNG_COLOR_RGBA:
+        return 4;
+
+    default:
+        return 0;
+    }
+}
+
+static bool png_valid_bit_depth(int color_type, int bit_depth)
+{
+    switch (color_type)
+    {
+    case PNG_COLOR_GRAY:
+        return bit_depth == 1 || bit_depth == 2 || bit_depth == 4 || bit_depth == 8 || bit_depth == 16;
+
+    case PNG_COLOR_PALETTE:
+        return bit_depth == 1 || bit_depth == 2 || bit_depth == 4 || bit_depth == 8;
+
+    default:
+        return bit_depth == 8 || bit_depth == 16;
+    }
+}
+
+static uint8_t png_paeth(int a, int b, int c)
+{
+    int p = a + b - c;
+    int pa = abs(p - a);
+    int pb = abs(p - b);
+    int pc = abs(p - c);
+
+    if (pa <= pb && pa <= pc)
+    {
+        return a;
+    }
+    else if (pb <= pc)
+    {
+        return b;
+    }
+    else
+    {
+        return c;
+    }
+}
+
+PNGDecoder::PNGDecoder(const char *path)
+{
+    _stream = stream_open(path, OPEN_READ);
+
+    if (handle_has_error(_stream))
+    {
+        _result = handle_get_error(_stream);
+        return;
+    }
+
+    read_header();
+}
+
+Result PNGDecoder::begin(int scale)
+{
+    if (_result != SUCCESS)
+    {
+        return _result;
+    }
+
+    _scale = MAX(scale, 1);
+
+    _channels = png_channels(_color_type);
+    _stride = ((size_t)_width * _channels * _bit_depth + 7) / 8;
+    _filter_bpp = MAX(_channels * _bit_depth / 8, 1);
+
+    _current_row = (uint8_t *)calloc(_stride + 1, 1);
+    _previous_row = (uint8_t *)calloc(_stride + 1, 1);
+    _colors = (Color *)calloc(_width, sizeof(Color));
+
+    int scaled_width = (_width + _scale - 1) / _scale;
+    int scaled_height = (_height + _scale - 1) / _scale;
+
+    if (_scale > 1)
+    {
+        _accumulator = (uint32_t *)calloc((size_t)scaled_width * 4, sizeof(uint32_t));
+    }
+
+    if (!_current_row || !_previous_row || !_colors || (_scale > 1 && !_accumulator))
+    {
+        _result = ERR_OUT_OF_MEMORY;
+        return _result;
+    }
+
+    auto bitmap_or_result = Bitmap::create_shared(scaled_width, scaled_height);
+
+    if (!bitmap_or_result.success())
+    {
+        _result = bitmap_or_result.result();
+        return _result;
+    }
+
+    _bitmap = bitmap_or_result.take_value();
+    _bitmap->clear(Colors::BLACKTRANSPARENT);
+
+    _inflate = new Inflate([this](uint8_t *buffer, size_t size) {
+        return read_image_data(buffer, size);
+    });
+
+    return SUCCESS;
+}
+
+PNGDecoder::~PNGDecoder()
+{
+    if (_inflate)
+    {
+        delete _inflate;
+    }
+
+    free(_current_row);
+    free(_previous_row);
+    free(_colors);
+    free(_accumulator);
+
+    if (_stream)
+    {
+        stream_close(_stream);
+    }
+}
+
+bool PNGDecoder::read_exact(void *buffer, size_t size)
+{
+    if (stream_read(_stream, buffer, size) != size)
+    {
+        _result = ERR_BAD_IMAGE_FILE_FORMAT;
+        return false;
+    }
+
+    return true;
+}
+
+uint32_t PNGDecoder::read_uint32()
+{
+    uint8_t bytes[4] = {};
+    read_exact(bytes, 4);
+
+    return (bytes[0] << 24) | (bytes[1] << 16) | (bytes[2] << 8) | bytes[3];
+}
+
+void PNGDecoder::read_header()
+{
+    uint8_t signature[8] = {};
+
+    if (!read_exact(signature, 8) || memcmp(signature, _png_signature, 8) != 0)
+    {
+        _result = ERR_BAD_IMAGE_FILE_FORMAT;
+        return;
+    }
+
+    bool has_header = false;
+
+    while (_result == SUCCESS)
+    {
+        uint32_t length = read_uint32();
+
+        char type[4] = {};
+        read_exact(type, 4);
+
+        if (_result != SUCCESS)
+        {
+            return;
+        }
+
+        if (memcmp(type, "IHDR", 4) == 0 && length == 13)
+        {
+            _width = read_uint32();
+            _height = read_uint32();
+
+            uint8_t fields[5] = {};
+            read_exact(fields, 5);
+
+            _bit_depth = fields[0];
+            _color_type = fields[1];
+
+            if (_width <= 0 || _height <= 0 ||
+                _width > PNG_MAX_SIZE || _height > PNG_MAX_SIZE ||
+                png_channels(_color_type) == 0 ||
+                !png_valid_bit_depth(_color_type, _bit_depth) ||
+                fields[2] != 0 || fields[3] != 0)
+            {
+                _result = ERR_BAD_IMAGE_FILE_FORMAT;
+                return;
+            }
+
+            // Interlaced images can't be decoded row by row.
+            if (fields[4] != 0)
+            {
+                _result = ERR_FUNCTION_NOT_IMPLEMENTED;
+                return;
+            }
+
+            has_header = true;
+        }
+        else if (memcmp(type, "PLTE", 4) == 0)
+        {
+            for (size_t i = 0; i < length / 3; i++)
+            {
+                uint8_t rgb[3] = {};
+                read_exact(rgb, 3);
+
+                if (i < 256)
+                {
+                    _palette[i] = Color::from_byte(rgb[0], rgb[1], rgb[2], 255);
+                }
+            }
+
+            stream_seek(_stream, length % 3, WHENCE_HERE);
+        }
+        else if (memcmp(type, "tRNS", 4) == 0 && _color_type == PNG_COLOR_PALETTE)
+        {
+            for (size_t i = 0; i < length; i++)
+            {
+                uint8_t alpha = 0;
+                read_exact(&alpha, 1);
+
+                if (i < 256)
+                {
+                    _palette[i] = _palette[i].with_alpha(alpha / 255.0);
+                }
+            }
+        }
+        else if (memcmp(type, "tRNS", 4) == 0 &&
+                 (_color_type == PNG_COLOR_GRAY || _color_type == PNG_COLOR_RGB) &&
+                 length == (_color_type == PNG_COLOR_GRAY ? 2u : 6u))
+        {
+            for (size_t i = 0; i < length / 2; i++)
+            {
+                uint8_t bytes[2] = {};
+                read_exact(bytes, 2);
+
+                _color_key[i] = (bytes[0] << 8) | bytes[1];
+            }
+
+            _has_color_key = true;
+        }
+        else if (memcmp(type, "IDAT", 4) == 0)
+        {
+            if (!has_header)
+            {
+                _result = ERR_BAD_IMAGE_FILE_FORMAT;
+            }
+
+            _chunk_remaining = length;
+            return;
+        }
+        else if (memcmp(type, "IEND", 4) == 0)
+        {
+            _result = ERR_BAD_IMAGE_FILE_FORMAT;
+            return;
+        }
+        else
+        {
+            stream_seek(_stream, length, WHENCE_HERE);
+        }
+
+        // Skip the crc.
+        stream_seek(_stream, 4, WHENCE_HERE);
+    }
+}
+
+size_t PNGDecoder::read_image_data(uint8_t *buffer, size_t size)
+{
+    // The compressed stream is split across consecutive IDAT chunks.
+    while (_chunk_remaining == 0)
+    {
+        if (_image_data_ended)
+        {
+            return 0;
+        }
+
+        stream_seek(_stream, 4, WHENCE_HERE);
+
+        uint8_t header[8] = {};
+
+        if (stream_read(_stream, header, 8) != 8 || memcmp(header + 4, "IDAT", 4) != 0)
+        {
+            _image_data_ended = true;
+            return 0;
+        }
+
+        _chunk_remaining = (header[0] << 24) | (header[1] << 16) | (header[2] << 8) | header[3];
+    }
+
+    size_t read = stream_read(_stream, buffer, MIN(size, _chunk_remaining));
+    _chunk_remaining -= read;
+
+    return read;
+}
+
+void PNGDecoder::unfilter_row()
+{
+    uint8_t filter = _current_row[0];
+    uint8_t *row = _current_row + 1;
+    uint8_t *previous = _previous_row + 1;
+
+    switch (filter)
+    {
+    case PNG_FILTER_NONE:
+        break;
+
+    case PNG_FILTER_SUB:
+        for (size_t i = _filter_bpp; i < _stride; i++)
+        {
+            row[i] += row[i - _filter_bpp];
+        }
+        break;
+
+    case PNG_FILTER_UP:
+        for (size_t i = 0; i < _stride; i++)
+        {
+            row[i] += previous[i];
+        }
+        break;
+
+    case PNG_FILTER_AVERAGE:
+        for (size_t i = 0; i < _stride; i++)
+        {
+            int left = i >= (size_t)_filter_bpp ? row[i - _filter_bpp] : 0;
+            row[i] += (left + previous[i]) / 2;
+        }
+        break;
+
+    case PNG_FILTER_PAETH:
+        for (size_t i = 0; i < _stride; i++)
+        {
+            int left = i >= (size_t)_filter_bpp ? row[i - _filter_bpp] : 0;
+            int upper_left = i >= (size_t)_filter_bpp ? previous[i - _filter_bpp] : 0;
+            row[i] += png_paeth(left, previous[i], upper_left);
+        }
+        break;
+
+    default:
+        _result = ERR_BAD_IMAGE_FILE_FORMAT;
+        break;
+    }
+}
+
+uint16_t PNGDecoder::sample(const uint8_t *row, int index)
+{
+    if (_bit_depth == 8)
+    {
+        return row[index];
+    }
+
+    if (_bit_depth == 16)
+    {
+        return (row[index * 2] << 8) | row[index * 2 + 1];
+    }
+
+    int bit = index * _bit_depth;
+
+    return (row[bit / 8] >> (8 - _bit_depth - bit % 8)) & ((1 << _bit_depth) - 1);
+}
+
+void PNGDecoder::convert_row()
+{
+    const uint8_t *row = _current_row + 1;
+
+    if (_color_type == PNG_COLOR_RGBA && _bit_depth == 8)
+    {
+        memcpy(_colors, row, _width * sizeof(Color));
+        return;
+    }
+
+    auto to_byte = [&](uint16_t value) -> uint8_t {
+        if (_bit_depth == 16)
+        {
+            return value >> 8;
+        }
+
+        if (_bit_depth < 8)
+        {
+            return value * 255 / ((1 << _bit_depth) - 1);
+        }
+
+        return value;
+    };
+
+    for (int x = 0; x < _width; x++)
+    {
+        switch (_color_type)
+        {
+        case PNG_COLOR_GRAY:
+        {
+            uint16_t gray = sample(row, x);
+            uint8_t alpha = (_has_color_key && gray == _color_key[0]) ? 0 : 255;
+
+            _colors[x] = Color::from_byte(to_byte(gray), to_byte(gray), to_byte(gray), alpha);
+            break;
+        }
+
+        case PNG_COLOR_RGB:
+        {
+            uint16_t red = sample(row, x * 3);
+            uint16_t green = sample(row, x * 3 + 1);
+            uint16_t blue = sample(row, x * 3 + 2);
+
+            uint8_t alpha = (_has_color_key &&
+                             red == _color_key[0] &&
+                             green == _color_key[1] &&
+                             blue == _color_key[2])
+                                ? 0
+                                : 255;
+
+            _colors[x] = Color::from_byte(to_byte(red), to_byte(green), to_byte(blue), alpha);
+            break;
+        }
+
+        case PNG_COLOR_PALETTE:
+            _colors[x] = _palette[sample(row, x)];
+            break;
+
+        case PNG_COLOR_GRAY_ALPHA:
+        {
+            uint8_t gray = to_byte(sample(row, x * 2));
+            _colors[x] = Color::from_byte(gray, gray, gray, to_byte(sample(row, x * 2 + 1)));
+            break;
+        }
+
+        case PNG_COLOR_RGBA:
+            _colors[x] = Color::from_byte(
+                to_byte(sample(row, x * 4)),
+                to_byte(sample(row, x * 4 + 1)),
+                to_byte(sample(row, x * 4 + 2)),
+                to_byte(sample(row, x * 4 + 3)));
+            break;
+        }
+    }
+}
+
+void PNGDecoder::output_row()
+{
+    if (_scale == 1)
+    {
+        memcpy(&_bitmap->pixels()[_row * _width], _colors, _width * sizeof(Color));
+        return;
+    }
+
+    // Box filter the source rows and columns falling into each destination pixel.
+    for (int x = 0; x < _width; x++)
+    {
+        uint32_t *sum = &_accumulator[(x / _scale) * 4];
+
+        sum[0] += _colors[x].red();
+        sum[1] += _colors[x].green();
+        sum[2] += _colors[x].blue();
+        sum[3] += _colors[x].alpha();
+    }
+
+    if ((_row + 1) % _scale != 0 && _row + 1 != _height)
+    {
+        return;
+    }
+
+    int rows = _row % _scale + 1;
+    int y = _row / _scale;
+
+    for (int x = 0; x < _bitmap->width(); x++)
+    {
+        uint32_t *sum = &_accumulator[x * 4];
+        uint32_t count = rows * MIN(_scale, _width - x * _scale);
+
+        _bitmap->pixels()[y * _bitmap->width() + x] = Color::from_byte(
+            sum[0] / count,
+            sum[1] / count,
+            sum[2] / count,
+            sum[3] / count);
+    }
+
+    memset(_accumulator, 0, _bitmap->width() * 4 * sizeof(uint32_t));
+}
+
+Result PNGDecoder::decode(int row_count)
+{
+    if (!_inflate)
+    {
+        return _result;
+    }
+
+    for (int i = 0; i < row_count && !done(); i++)
+    {
+        _result = _inflate->read(_current_row, _stride + 1);
+
+        if (_result != SUCCESS)
+        {
+            return _result;
+        }
+
+        unfilter_row();
+
+        if (_result != SUCCESS)
+        {
+            return _result;
+        }
+
+        convert_row();
+        output_row();
+
+        swap(_current_row, _previous_row);
+        _row++;
+    }
+
+    return _result;
+}
+
+ResultOr<RefPtr<Bitmap>> PNGDecoder::load(const char *path, int scale)
+{
+    PNGDecoder decoder{path};
+    decoder.begin(scale);
+
+    while (!decoder.done())
+    {
+        decoder.decode(decoder.height());
+    }
+
+    if (decoder.result() != SUCCESS)
+    {
+        return decoder.result();
+    }
+
+    return decoder.bitmap();
+}
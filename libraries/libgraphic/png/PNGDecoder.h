@@ -0,0 +1,81 @@
+#pragma once
+
+#include <libgraphic/Bitmap.h>
+#include <libgraphic/png/Inflate.h>
+#include <libsystem/io/Stream.h>
+
+// Decode a png a few rows at the time straight into a shared bitmap.
+// Only two rows of filtered data and the inflate window are kept around,
+// and the image can be downscaled by an integer factor while decoding.
+class PNGDecoder
+{
+private:
+    Stream *_stream = nullptr;
+    Result _result = SUCCESS;
+
+    int _width = 0;
+    int _height = 0;
+    int _bit_depth = 0;
+    int _color_type = 0;
+    int _channels = 0;
+
+    Color _palette[256] = {};
+    bool _has_color_key = false;
+    uint16_t _color_key[3] = {};
+
+    size_t _chunk_remaining = 0;
+    bool _image_data_ended = false;
+    Inflate *_inflate = nullptr;
+
+    size_t _stride = 0;
+    int _filter_bpp = 0;
+    uint8_t *_current_row = nullptr;
+    uint8_t *_previous_row = nullptr;
+    Color *_colors = nullptr;
+
+    int _scale = 1;
+    uint32_t *_accumulator = nullptr;
+    int _row = 0;
+
+    RefPtr<Bitmap> _bitmap;
+
+    bool read_exact(void *buffer, size_t size);
+
+    uint32_t read_uint32();
+
+    void read_header();
+
+    size_t read_image_data(uint8_t *buffer, size_t size);
+
+    void unfilter_row();
+
+    uint16_t sample(const uint8_t *row, int index);
+
+    void convert_row();
+
+    void output_row();
+
+public:
+    int width() { return _width; }
+
+    int height() { return _height; }
+
+    bool done() { return _result != SUCCESS || !_inflate || _row == _height; }
+
+    Result result() { return _result; }
+
+    RefPtr<Bitmap> bitmap() { return _bitmap; }
+
+    // Open the file and read everything up to the image data.
+    PNGDecoder(const char *path);
+
+    ~PNGDecoder();
+
+    // Allocate the bitmap, already downscaled by the scale factor.
+    Result begin(int scale = 1);
+
+    // Decode at most row_count more rows of the source image.
+    Result decode(int row_count);
+
+    static ResultOr<RefPtr<Bitmap>> load(const char *path, int scale = 1);
+};
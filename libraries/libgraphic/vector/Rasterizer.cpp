@@ -1,5 +1,6 @@
 #include <libgraphic/Painter.h>
 #include <libgraphic/vector/Rasterizer.h>
+#include <libsystem/math/Math.h>
 
 namespace graphic
 {
@@ -84,4 +85,221 @@ void Rasterizer::stroke(Painter &painter, Path &path, Vec2f position, Trans2f tr
         }
     }
 }
+
+void Rasterizer::add_edge(Vec2f from, Vec2f to)
+{
+    // Horizontal edges never cross a sample, they don't contribute.
+    if (from.y() == to.y())
+    {
+        return;
+    }
+
+    if (from.y() < to.y())
+    {
+        _edges.push_back({from.x(), from.y(), to.x(), to.y(), 1});
+    }
+    else
+    {
+        _edges.push_back({to.x(), to.y(), from.x(), from.y(), -1});
+    }
+}
+
+void Rasterizer::flatten_edges(Path &path, Vec2f position, Trans2f transform)
+{
+    _edges.clear();
+
+    for (size_t i = 0; i < path.subpath_count(); i++)
+    {
+        _points.clear();
+
+        auto &subpath = path.subpath(i);
+
+        _points.push_back(transform.apply(subpath.first_point()) + position);
+
+        for (size_t j = 0; j < subpath.length(); j++)
+        {
+            auto curve = subpath.curves(j);
+
+            curve.start = transform.apply(curve.start) + position;
+            curve.first_control_point = transform.apply(curve.first_control_point) + position;
+            curve.second_contol_point = transform.apply(curve.second_contol_point) + position;
+            curve.end = transform.apply(curve.end) + position;
+
+            flatten(curve);
+        }
+
+        // Filled subpaths are always implicitly closed.
+        for (size_t j = 0; j < _points.count(); j++)
+        {
+            add_edge(_points[j], _points[(j + 1) % _points.count()]);
+        }
+    }
+
+    // Sort the edges by their top, so they can be activated while scanning down.
+    Edge *edges = _edges.raw_storage();
+
+    for (size_t i = 1; i < _edges.count(); i++)
+    {
+        Edge edge = edges[i];
+        size_t j = i;
+
+        for (; j > 0 && edges[j - 1].y0 > edge.y0; j--)
+        {
+            edges[j] = edges[j - 1];
+        }
+
+        edges[j] = edge;
+    }
+}
+
+void Rasterizer::accumulate_span(float from, float to, int origin, int width)
+{
+    float start = clamp(from - origin, 0.0f, (float)width);
+    float end = clamp(to - origin, 0.0f, (float)width);
+
+    if (start >= end)
+    {
+        return;
+    }
+
+    uint8_t *coverage = _coverage.raw_storage();
+
+    int start_pixel = (int)start;
+    int end_pixel = (int)end;
+
+    if (start_pixel == end_pixel)
+    {
+        coverage[start_pixel] += (end - start) * SUBSAMPLE_COVERAGE;
+        return;
+    }
+
+    coverage[start_pixel] += (start_pixel + 1 - start) * SUBSAMPLE_COVERAGE;
+
+    for (int x = start_pixel + 1; x < end_pixel; x++)
+    {
+        coverage[x] += SUBSAMPLE_COVERAGE;
+    }
+
+    if (end_pixel < width)
+    {
+        coverage[end_pixel] += (end - end_pixel) * SUBSAMPLE_COVERAGE;
+    }
+}
+
+void Rasterizer::rasterize_subsample(float y, FillRule rule, int origin, int width)
+{
+    while (_next_edge < _edges.count() && _edges[_next_edge].y0 <= y)
+    {
+        _active.push_back(_next_edge);
+        _next_edge++;
+    }
+
+    _active.remove_all_match([&](size_t index) {
+        return _edges[index].y1 <= y;
+    });
+
+    _crossings.clear();
+
+    for (size_t i = 0; i < _active.count(); i++)
+    {
+        Edge &edge = _edges[_active[i]];
+
+        float t = (y - edge.y0) / (edge.y1 - edge.y0);
+        _crossings.push_back({edge.x0 + t * (edge.x1 - edge.x0), edge.winding});
+    }
+
+    Crossing *crossings = _crossings.raw_storage();
+
+    for (size_t i = 1; i < _crossings.count(); i++)
+    {
+        Crossing crossing = crossings[i];
+        size_t j = i;
+
+        for (; j > 0 && crossings[j - 1].x > crossing.x; j--)
+        {
+            crossings[j] = crossings[j - 1];
+        }
+
+        crossings[j] = crossing;
+    }
+
+    auto inside = [&](int winding) {
+        if (rule == FillRule::NONZERO)
+        {
+            return winding != 0;
+        }
+        else
+        {
+            return (winding & 1) == 1;
+        }
+    };
+
+    int winding = 0;
+    float span_start = 0;
+
+    for (size_t i = 0; i < _crossings.count(); i++)
+    {
+        bool was_inside = inside(winding);
+        winding += crossings[i].winding;
+        bool is_inside = inside(winding);
+
+        if (!was_inside && is_inside)
+        {
+            span_start = crossings[i].x;
+        }
+        else if (was_inside && !is_inside)
+        {
+            accumulate_span(span_start, crossings[i].x, origin, width);
+        }
+    }
+}
+
+void Rasterizer::fill(Painter &painter, Path &path, Vec2f position, Trans2f transform, Color color, FillRule rule)
+{
+    flatten_edges(path, position, transform);
+
+    if (_edges.empty())
+    {
+        return;
+    }
+
+    float min_x = _edges[0].x0;
+    float max_x = _edges[0].x0;
+    float min_y = _edges[0].y0;
+    float max_y = _edges[0].y1;
+
+    for (size_t i = 0; i < _edges.count(); i++)
+    {
+        min_x = MIN(min_x, MIN(_edges[i].x0, _edges[i].x1));
+        max_x = MAX(max_x, MAX(_edges[i].x0, _edges[i].x1));
+        min_y = MIN(min_y, _edges[i].y0);
+        max_y = MAX(max_y, _edges[i].y1);
+    }
+
+    int left = floorf(min_x);
+    int width = (int)ceilf(max_x) - left;
+    int top = floorf(min_y);
+    int bottom = ceilf(max_y);
+
+    while (_coverage.count() < (size_t)width)
+    {
+        _coverage.push_back(0);
+    }
+
+    _active.clear();
+    _next_edge = 0;
+
+    for (int y = top; y < bottom; y++)
+    {
+        memset(_coverage.raw_storage(), 0, width);
+
+        for (int sample = 0; sample < SUBSAMPLES; sample++)
+        {
+            rasterize_subsample(y + (sample + 0.5f) / SUBSAMPLES, rule, left, width);
+        }
+
+        painter.blend_scanline(Vec2i(left, y), _coverage.raw_storage(), width, color);
+    }
+}
+
 } // namespace graphic
@@ -9,15 +9,55 @@ class Painter;
 namespace graphic
 {
 
+enum class FillRule
+{
+    NONZERO,
+    EVENODD,
+};
+
+struct Edge
+{
+    float x0;
+    float y0;
+    float x1;
+    float y1;
+    int winding;
+};
+
+struct Crossing
+{
+    float x;
+    int winding;
+};
+
 class Rasterizer
 {
 private:
     Vector<Vec2f> _points;
 
+    // Kept between calls, so filling the same shapes every frame doesn't allocate.
+    Vector<Edge> _edges;
+    Vector<size_t> _active;
+    size_t _next_edge = 0;
+    Vector<Crossing> _crossings;
+    Vector<uint8_t> _coverage;
+
+    void add_edge(Vec2f from, Vec2f to);
+
+    void flatten_edges(Path &path, Vec2f position, Trans2f transform);
+
+    void accumulate_span(float from, float to, int origin, int width);
+
+    void rasterize_subsample(float y, FillRule rule, int origin, int width);
+
 public:
     static constexpr auto TOLERANCE = 0.25f;
     static constexpr auto MAX_DEPTH = 8;
 
+    // Vertical samples per pixel, horizontal coverage is computed exactly.
+    static constexpr auto SUBSAMPLES = 5;
+    static constexpr auto SUBSAMPLE_COVERAGE = 255 / SUBSAMPLES;
+
     Rasterizer()
     {
     }
@@ -28,9 +68,7 @@ public:
 
     void rasterize();
 
-    // void fill(Path &path, Vec2f position, Trans2f transform, Color color)
-    // {
-    // }
+    void fill(Painter &painter, Path &path, Vec2f position, Trans2f transform, Color color, FillRule rule = FillRule::NONZERO);
 
     void stroke(Painter &painter, Path &path, Vec2f position, Trans2f transform, Color color);
 };
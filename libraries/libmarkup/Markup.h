@@ -41,7 +41,7 @@ public:
     Node(String type, int flags, Attributes &&attributes)
         : _type(type),
           _flags(flags),
-          _attributes(attributes)
+          _attributes(move(attributes))
     {
     }
 
@@ -118,6 +118,8 @@ public:
 
 Node parse(Scanner &scan);
 
+Node parse(const char *str, size_t size);
+
 Node parse_file(const char *path);
 
 void prettify(Prettifier &pretty, Node &node);
@@ -1,6 +1,7 @@
 #include <libsystem/Assert.h>
 #include <libsystem/Logger.h>
 #include <libsystem/core/CString.h>
+#include <libsystem/io/File.h>
 #include <libsystem/unicode/Codepoint.h>
 #include <libsystem/utils/NumberParser.h>
 #include <libutils/Scanner.h>
@@ -13,31 +14,48 @@
 namespace markup
 {
 
-static void whitespace(Scanner &scan)
+static bool is_alpha(char chr)
 {
-    scan.eat(Strings::WHITESPACE);
+    return (chr >= 'a' && chr <= 'z') || (chr >= 'A' && chr <= 'Z');
 }
 
-static String identifier(Scanner &scan)
+static void whitespace(SpanScanner &scan)
 {
-    StringBuilder builder{};
+    scan.eat_whitespace();
+}
 
-    while (scan.current_is(Strings::ALL_ALPHA) &&
-           scan.do_continue())
-    {
-        builder.append(scan.current());
-        scan.foreward();
-    }
+static String identifier(SpanScanner &scan)
+{
+    const char *start = scan.position();
+    size_t length = scan.eat_while(is_alpha);
 
-    return builder.finalize();
+    return String(start, length);
 }
 
-static String string(Scanner &scan)
+static size_t string_run(SpanScanner &scan)
 {
-    StringBuilder builder{};
+    return scan.eat_while([](char chr) {
+        return chr != '"' && chr != '\\';
+    });
+}
 
+static String string(SpanScanner &scan)
+{
     scan.skip('"');
 
+    // Most strings have no escape sequences and are copied in one go.
+    const char *start = scan.position();
+    size_t length = string_run(scan);
+
+    if (scan.current() != '\\')
+    {
+        scan.skip('"');
+        return String(start, length);
+    }
+
+    StringBuilder builder{length + 16};
+    builder.append(start, length);
+
     while (scan.do_continue() &&
            scan.current() != '"')
     {
@@ -47,8 +65,9 @@ static String string(Scanner &scan)
         }
         else
         {
-            builder.append(scan.current());
-            scan.foreward();
+            start = scan.position();
+            length = string_run(scan);
+            builder.append(start, length);
         }
     }
 
@@ -57,7 +76,7 @@ static String string(Scanner &scan)
     return builder.finalize();
 }
 
-static void attribute(Scanner &scan, Attributes &attr)
+static void attribute(SpanScanner &scan, Attributes &attr)
 {
     auto ident = identifier(scan);
 
@@ -74,7 +93,7 @@ static void attribute(Scanner &scan, Attributes &attr)
     }
 }
 
-static Node opening_tag(Scanner &scan)
+static Node opening_tag(SpanScanner &scan)
 {
     if (!scan.skip('<'))
     {
@@ -89,8 +108,7 @@ static Node opening_tag(Scanner &scan)
 
     Attributes attr{};
 
-    while (scan.current_is(Strings::ALL_ALPHA) &&
-           scan.do_continue())
+    while (is_alpha(scan.current()))
     {
         attribute(scan, attr);
         whitespace(scan);
@@ -110,7 +128,7 @@ static Node opening_tag(Scanner &scan)
     return {type, flags, move(attr)};
 }
 
-static void closing_tag(Scanner &scan, const Node &node)
+static void closing_tag(SpanScanner &scan, const Node &node)
 {
     scan.skip('<');
     scan.skip('/');
@@ -132,7 +150,7 @@ static void closing_tag(Scanner &scan, const Node &node)
     scan.skip('>');
 }
 
-static Node node(Scanner &scan)
+static Node node(SpanScanner &scan)
 {
     whitespace(scan);
 
@@ -162,22 +180,42 @@ static Node node(Scanner &scan)
 
 Node parse(Scanner &scan)
 {
+    // Read everything first, the parser itself only works on buffers.
+    StringBuilder builder{};
+
+    while (scan.do_continue())
+    {
+        builder.append(scan.current());
+        scan.foreward();
+    }
+
+    auto content = builder.finalize();
+
+    return parse(content.cstring(), content.length());
+}
+
+Node parse(const char *str, size_t size)
+{
+    SpanScanner scan{str, size};
     scan_skip_utf8bom(scan);
     return node(scan);
 }
 
 Node parse_file(const char *path)
 {
-    __cleanup(stream_cleanup) Stream *json_file = stream_open(path, OPEN_READ);
+    char *buffer = nullptr;
+    size_t size = 0;
 
-    if (handle_has_error(json_file))
+    if (file_read_all(path, (void **)&buffer, &size) != SUCCESS)
     {
         return {"error"};
     }
 
-    StreamScanner scan{json_file};
-    scan_skip_utf8bom(scan);
-    return node(scan);
+    auto root = parse(buffer, size);
+
+    free(buffer);
+
+    return root;
 }
 
 } // namespace markup
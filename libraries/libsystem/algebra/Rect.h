@@ -472,6 +472,19 @@ public:
                (_y <= other._y && (_y + _height) >= (other._y + other._width));
     }
 
+    bool operator==(const Rectangle &other) const
+    {
+        return _x == other._x &&
+               _y == other._y &&
+               _width == other._width &&
+               _height == other._height;
+    }
+
+    bool operator!=(const Rectangle &other) const
+    {
+        return !(*this == other);
+    }
+
     RectangleBorder contains(Insets spacing, Vec2i position) const
     {
         RectangleBorder borders = RectangleBorder::NONE;
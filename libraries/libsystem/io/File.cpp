@@ -1,5 +1,6 @@
 #include <libsystem/io/File.h>
 #include <libsystem/io/Stream.h>
+#include <libsystem/math/MinMax.h>
 
 Result file_read_all(const char *path, void **buffer, size_t *size)
 {
@@ -18,17 +19,38 @@ Result file_read_all(const char *path, void **buffer, size_t *size)
         return handle_get_error(stream);
     }
 
-    *buffer = malloc(state.size);
-    *size = state.size;
+    // Generated files like the ones in /System have no size, the stat size is only a hint.
+    size_t capacity = MAX(state.size + 1, 4096);
+    size_t used = 0;
+    char *data = (char *)malloc(capacity);
 
-    stream_read(stream, *buffer, state.size);
-
-    if (handle_has_error(stream))
+    while (true)
     {
-        free(buffer);
-        return handle_get_error(stream);
+        if (used == capacity)
+        {
+            capacity *= 2;
+            data = (char *)realloc(data, capacity);
+        }
+
+        size_t read = stream_read(stream, data + used, capacity - used);
+
+        if (handle_has_error(stream))
+        {
+            free(data);
+            return handle_get_error(stream);
+        }
+
+        if (read == 0)
+        {
+            break;
+        }
+
+        used += read;
     }
 
+    *buffer = data;
+    *size = used;
+
     return SUCCESS;
 }
 
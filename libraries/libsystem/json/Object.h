@@ -1,14 +1,201 @@
 #pragma once
 
 #include <libsystem/json/Value.h>
-#include <libutils/HashMap.h>
+#include <libutils/Hash.h>
 #include <libutils/String.h>
+#include <libutils/Vector.h>
 
 namespace json
 {
 
-struct Object : public HashMap<String, Value>
+// Members are kept in the order they were added. Most objects only have a
+// handful of them and are searched linearly, an index is built past
+// INDEX_THRESHOLD members.
+struct Object
 {
+private:
+    static constexpr size_t INDEX_THRESHOLD = 16;
+
+    struct Member
+    {
+        uint32_t hash;
+        String key;
+        Value value;
+    };
+
+    Vector<Member> _members{};
+
+    // Open addressing table of member index + 1, 0 being an empty slot.
+    uint32_t *_index = nullptr;
+    size_t _index_capacity = 0;
+
+    void index_insert(uint32_t hash, size_t member)
+    {
+        size_t mask = _index_capacity - 1;
+        size_t slot = hash & mask;
+
+        while (_index[slot])
+        {
+            slot = (slot + 1) & mask;
+        }
+
+        _index[slot] = member + 1;
+    }
+
+    void reindex()
+    {
+        delete[] _index;
+        _index = nullptr;
+        _index_capacity = 0;
+
+        if (_members.count() <= INDEX_THRESHOLD)
+        {
+            return;
+        }
+
+        _index_capacity = 64;
+
+        while (_index_capacity < _members.count() * 2)
+        {
+            _index_capacity *= 2;
+        }
+
+        _index = new uint32_t[_index_capacity]{};
+
+        for (size_t i = 0; i < _members.count(); i++)
+        {
+            index_insert(_members[i].hash, i);
+        }
+    }
+
+    int find(const String &key, uint32_t hash) const
+    {
+        if (_index)
+        {
+            size_t mask = _index_capacity - 1;
+
+            for (size_t slot = hash & mask; _index[slot]; slot = (slot + 1) & mask)
+            {
+                const Member &member = _members[_index[slot] - 1];
+
+                if (member.hash == hash && member.key == key)
+                {
+                    return _index[slot] - 1;
+                }
+            }
+
+            return -1;
+        }
+
+        for (size_t i = 0; i < _members.count(); i++)
+        {
+            if (_members[i].hash == hash && _members[i].key == key)
+            {
+                return i;
+            }
+        }
+
+        return -1;
+    }
+
+public:
+    size_t count() const { return _members.count(); }
+
+    Object()
+    {
+    }
+
+    Object(const Object &other)
+        : _members(other._members)
+    {
+        reindex();
+    }
+
+    Object(Object &&other)
+        : _members(move(other._members))
+    {
+        swap(_index, other._index);
+        swap(_index_capacity, other._index_capacity);
+    }
+
+    ~Object()
+    {
+        delete[] _index;
+    }
+
+    Object &operator=(const Object &other)
+    {
+        if (this != &other)
+        {
+            _members = other._members;
+            reindex();
+        }
+
+        return *this;
+    }
+
+    Object &operator=(Object &&other)
+    {
+        swap(_members, other._members);
+        swap(_index, other._index);
+        swap(_index_capacity, other._index_capacity);
+
+        return *this;
+    }
+
+    bool has_key(const String &key) const
+    {
+        return find(key, hash<String>(key)) >= 0;
+    }
+
+    void remove_key(const String &key)
+    {
+        int index = find(key, hash<String>(key));
+
+        if (index >= 0)
+        {
+            _members.remove_index(index);
+            reindex();
+        }
+    }
+
+    Value &operator[](const String &key)
+    {
+        uint32_t h = hash<String>(key);
+        int index = find(key, h);
+
+        if (index >= 0)
+        {
+            return _members[index].value;
+        }
+
+        _members.push_back({h, key, {}});
+
+        if (_index && _members.count() * 2 <= _index_capacity)
+        {
+            index_insert(h, _members.count() - 1);
+        }
+        else if (_members.count() > INDEX_THRESHOLD)
+        {
+            reindex();
+        }
+
+        return _members[_members.count() - 1].value;
+    }
+
+    template <typename TCallback>
+    Iteration foreach (TCallback callback) const
+    {
+        for (size_t i = 0; i < _members.count(); i++)
+        {
+            if (callback(_members[i].key, _members[i].value) == Iteration::STOP)
+            {
+                return Iteration::STOP;
+            }
+        }
+
+        return Iteration::CONTINUE;
+    }
 };
 
 } // namespace json
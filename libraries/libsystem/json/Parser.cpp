@@ -1,6 +1,6 @@
 #include <libsystem/Assert.h>
 #include <libsystem/core/CString.h>
-#include <libsystem/io/Stream.h>
+#include <libsystem/io/File.h>
 #include <libsystem/json/Json.h>
 #include <libsystem/unicode/Codepoint.h>
 #include <libsystem/utils/NumberParser.h>
@@ -12,14 +12,37 @@
 namespace json
 {
 
-static Value value(Scanner &scan);
+// The objects of a document tend to use the same keys over and over,
+// recent ones are shared instead of allocating a new string each time.
+struct Keys
+{
+    static constexpr size_t CACHE_SIZE = 64;
+
+    RefPtr<StringStorage> cache[CACHE_SIZE];
+
+    String intern(const char *key, size_t length)
+    {
+        auto &slot = cache[hash(key, length) % CACHE_SIZE];
 
-static void whitespace(Scanner &scan)
+        if (slot.naked() == nullptr ||
+            slot->length() != length ||
+            memcmp(slot->cstring(), key, length) != 0)
+        {
+            slot = make<StringStorage>(key, length);
+        }
+
+        return String(slot);
+    }
+};
+
+static Value value(SpanScanner &scan, Keys &keys);
+
+static void whitespace(SpanScanner &scan)
 {
-    scan.eat(Strings::WHITESPACE);
+    scan.eat_whitespace();
 }
 
-static Value number(Scanner &scan)
+static Value number(SpanScanner &scan)
 {
 #ifdef __KERNEL__
     return Value{scan_int(scan, 10)};
@@ -28,12 +51,30 @@ static Value number(Scanner &scan)
 #endif
 }
 
-static String string(Scanner &scan)
+static size_t string_run(SpanScanner &scan)
 {
-    StringBuilder builder{};
+    return scan.eat_while([](char chr) {
+        return chr != '"' && chr != '\\';
+    });
+}
 
+static String string(SpanScanner &scan)
+{
     scan.skip('"');
 
+    // Most strings have no escape sequences and are copied in one go.
+    const char *start = scan.position();
+    size_t length = string_run(scan);
+
+    if (scan.current() != '\\')
+    {
+        scan.skip('"');
+        return String(start, length);
+    }
+
+    StringBuilder builder{length + 16};
+    builder.append(start, length);
+
     while (scan.current() != '"' && scan.do_continue())
     {
         if (scan.current() == '\\')
@@ -42,8 +83,9 @@ static String string(Scanner &scan)
         }
         else
         {
-            builder.append(scan.current());
-            scan.foreward();
+            start = scan.position();
+            length = string_run(scan);
+            builder.append(start, length);
         }
     }
 
@@ -52,7 +94,34 @@ static String string(Scanner &scan)
     return builder.finalize();
 }
 
-static Value array(Scanner &scan)
+static String key(SpanScanner &scan, Keys &keys)
+{
+    if (scan.current() != '"')
+    {
+        return string(scan);
+    }
+
+    const char *start = scan.position() + 1;
+
+    // Keys with escape sequences are rare enough to not be worth sharing.
+    for (size_t i = 0; i + 1 < scan.remaining(); i++)
+    {
+        if (start[i] == '\\')
+        {
+            break;
+        }
+
+        if (start[i] == '"')
+        {
+            scan.foreward(i + 2);
+            return keys.intern(start, i);
+        }
+    }
+
+    return string(scan);
+}
+
+static Value array(SpanScanner &scan, Keys &keys)
 {
     scan.skip('[');
 
@@ -70,7 +139,7 @@ static Value array(Scanner &scan)
     do
     {
         scan.skip(',');
-        array.push_back(value(scan));
+        array.push_back(value(scan, keys));
         index++;
     } while (scan.current() == ',');
 
@@ -79,7 +148,7 @@ static Value array(Scanner &scan)
     return move(array);
 }
 
-static Value object(Scanner &scan)
+static Value object(SpanScanner &scan, Keys &keys)
 {
     scan.skip('{');
 
@@ -92,14 +161,14 @@ static Value object(Scanner &scan)
         return move(object);
     }
 
-    while (scan.current() != '}')
+    while (scan.current() != '}' && scan.do_continue())
     {
-        auto k = string(scan);
+        auto k = key(scan, keys);
         whitespace(scan);
 
         scan.skip(':');
 
-        object[k] = value(scan);
+        object[k] = value(scan, keys);
 
         scan.skip(',');
 
@@ -108,27 +177,21 @@ static Value object(Scanner &scan)
 
     scan.skip('}');
 
-    return object;
+    return move(object);
 }
 
-static Value keyword(Scanner &scan)
+static Value keyword(SpanScanner &scan)
 {
-    StringBuilder builder{};
-
-    while (scan.current_is(Strings::LOWERCASE_ALPHA) &&
-           scan.do_continue())
-    {
-        builder.append(scan.current());
-        scan.foreward();
-    }
+    const char *keyword = scan.position();
+    size_t length = scan.eat_while([](char chr) {
+        return chr >= 'a' && chr <= 'z';
+    });
 
-    auto keyword = builder.finalize();
-
-    if (keyword == "true")
+    if (length == 4 && memcmp(keyword, "true", 4) == 0)
     {
         return true;
     }
-    else if (keyword == "false")
+    else if (length == 5 && memcmp(keyword, "false", 5) == 0)
     {
         return false;
     }
@@ -138,7 +201,7 @@ static Value keyword(Scanner &scan)
     }
 }
 
-static Value value(Scanner &scan)
+static Value value(SpanScanner &scan, Keys &keys)
 {
     whitespace(scan);
 
@@ -155,11 +218,11 @@ static Value value(Scanner &scan)
     }
     else if (scan.current() == '{')
     {
-        value = object(scan);
+        value = object(scan, keys);
     }
     else if (scan.current() == '[')
     {
-        value = array(scan);
+        value = array(scan, keys);
     }
     else
     {
@@ -173,28 +236,44 @@ static Value value(Scanner &scan)
 
 Value parse(Scanner &scan)
 {
-    scan_skip_utf8bom(scan);
-    return value(scan);
+    // Read everything first, the parser itself only works on buffers.
+    StringBuilder builder{};
+
+    while (scan.do_continue())
+    {
+        builder.append(scan.current());
+        scan.foreward();
+    }
+
+    auto content = builder.finalize();
+
+    return parse(content.cstring(), content.length());
 }
 
 Value parse(const char *str, size_t size)
 {
-    StringScanner scan{str, size};
-    return parse(scan);
-};
+    SpanScanner scan{str, size};
+    scan_skip_utf8bom(scan);
+
+    Keys keys{};
+    return value(scan, keys);
+}
 
 Value parse_file(const char *path)
 {
-    __cleanup(stream_cleanup) Stream *json_file = stream_open(path, OPEN_READ);
+    char *buffer = nullptr;
+    size_t size = 0;
 
-    if (handle_has_error(json_file))
+    if (file_read_all(path, (void **)&buffer, &size) != SUCCESS)
     {
         return nullptr;
     }
 
-    StreamScanner scan{json_file};
-    scan_skip_utf8bom(scan);
-    return value(scan);
+    auto root = parse(buffer, size);
+
+    free(buffer);
+
+    return root;
 }
 
 } // namespace json
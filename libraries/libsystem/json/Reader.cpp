@@ -0,0 +1,220 @@
+#include <libsystem/core/CString.h>
+#include <libsystem/json/Reader.h>
+#include <libutils/ScannerUtils.h>
+#include <libutils/StringBuilder.h>
+
+namespace json
+{
+
+Reader::Reader(const char *buffer, size_t size)
+    : _scan(buffer, size)
+{
+    scan_skip_utf8bom(_scan);
+}
+
+void Reader::read_string()
+{
+    auto string_run = [&]() {
+        return _scan.eat_while([](char chr) {
+            return chr != '"' && chr != '\\';
+        });
+    };
+
+    _scan.skip('"');
+
+    _string = _scan.position();
+    _length = string_run();
+
+    if (_scan.current() == '\\')
+    {
+        StringBuilder builder{_length + 16};
+        builder.append(_string, _length);
+
+        while (_scan.current() != '"' && _scan.do_continue())
+        {
+            if (_scan.current() == '\\')
+            {
+                builder.append(scan_json_escape_sequence(_scan));
+            }
+            else
+            {
+                const char *start = _scan.position();
+                size_t length = string_run();
+                builder.append(start, length);
+            }
+        }
+
+        _decoded = builder.finalize();
+        _string = _decoded.cstring();
+        _length = _decoded.length();
+    }
+
+    _scan.skip('"');
+}
+
+void Reader::read_number()
+{
+    SpanScanner start = _scan;
+
+    _scan.skip('-');
+    _scan.eat_while([](char chr) { return chr >= '0' && chr <= '9'; });
+
+#ifndef __KERNEL__
+    if (_scan.current_is(".eE"))
+    {
+        _scan = start;
+        _double = scan_float(_scan);
+        _integer = _double;
+        _token = Token::DOUBLE;
+
+        return;
+    }
+#endif
+
+    _scan = start;
+    _integer = scan_int(_scan, 10);
+
+#ifndef __KERNEL__
+    _double = _integer;
+#endif
+
+    _token = Token::INTEGER;
+}
+
+void Reader::read_keyword()
+{
+    const char *keyword = _scan.position();
+    size_t length = _scan.eat_while([](char chr) {
+        return chr >= 'a' && chr <= 'z';
+    });
+
+    if (length == 4 && memcmp(keyword, "true", 4) == 0)
+    {
+        _token = Token::TRUE;
+    }
+    else if (length == 5 && memcmp(keyword, "false", 5) == 0)
+    {
+        _token = Token::FALSE;
+    }
+    else if (length == 4 && memcmp(keyword, "null", 4) == 0)
+    {
+        _token = Token::NIL;
+    }
+    else
+    {
+        // Not json, stop here.
+        _token = Token::END;
+    }
+}
+
+Token Reader::next()
+{
+    // Commas and colons only separate tokens.
+    _scan.eat_while([](char chr) {
+        return chr == ' ' || chr == '\n' || chr == '\r' || chr == '\t' || chr == ',';
+    });
+
+    if (_scan.ended())
+    {
+        _token = Token::END;
+        return _token;
+    }
+
+    char chr = _scan.current();
+
+    if (chr == '{' || chr == '}' || chr == '[' || chr == ']')
+    {
+        _scan.foreward();
+
+        _token = chr == '{'   ? Token::BEGIN_OBJECT
+                 : chr == '}' ? Token::END_OBJECT
+                 : chr == '[' ? Token::BEGIN_ARRAY
+                              : Token::END_ARRAY;
+    }
+    else if (chr == '"')
+    {
+        read_string();
+
+        _scan.eat_whitespace();
+        _token = _scan.skip(':') ? Token::KEY : Token::STRING;
+    }
+    else if (chr == '-' || (chr >= '0' && chr <= '9'))
+    {
+        read_number();
+    }
+    else
+    {
+        read_keyword();
+    }
+
+    return _token;
+}
+
+void Reader::skip()
+{
+    if (_token != Token::BEGIN_OBJECT && _token != Token::BEGIN_ARRAY)
+    {
+        return;
+    }
+
+    int depth = 1;
+
+    while (depth > 0)
+    {
+        switch (next())
+        {
+        case Token::BEGIN_OBJECT:
+        case Token::BEGIN_ARRAY:
+            depth++;
+            break;
+
+        case Token::END_OBJECT:
+        case Token::END_ARRAY:
+            depth--;
+            break;
+
+        case Token::END:
+            return;
+
+        default:
+            break;
+        }
+    }
+}
+
+String Reader::string()
+{
+    return String(_string, _length);
+}
+
+bool Reader::string_is(const char *string)
+{
+    return strlen(string) == _length &&
+           memcmp(_string, string, _length) == 0;
+}
+
+int Reader::integer()
+{
+    if (_token == Token::TRUE)
+    {
+        return 1;
+    }
+
+    return _integer;
+}
+
+#ifndef __KERNEL__
+
+double Reader::number()
+{
+    return _double;
+}
+
+#endif
+
+bool Reader::boolean()
+{
+    return _token == Token::TRUE;
+}
+
+} // namespace json
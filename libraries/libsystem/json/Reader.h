@@ -0,0 +1,79 @@
+#pragma once
+
+#include <libutils/Scanner.h>
+#include <libutils/String.h>
+
+namespace json
+{
+
+enum class Token
+{
+    BEGIN_OBJECT,
+    END_OBJECT,
+    BEGIN_ARRAY,
+    END_ARRAY,
+    KEY,
+    STRING,
+    INTEGER,
+
+#ifndef __KERNEL__
+    DOUBLE,
+#endif
+
+    TRUE,
+    FALSE,
+    NIL,
+
+    END,
+};
+
+// Reads a json document one token at a time, for consumers that only
+// pick a few fields out of it and don't need a tree of Values.
+class Reader
+{
+private:
+    SpanScanner _scan;
+    Token _token = Token::END;
+
+    // Strings without escape sequences point into the document.
+    const char *_string = nullptr;
+    size_t _length = 0;
+    String _decoded{};
+
+    int _integer = 0;
+
+#ifndef __KERNEL__
+    double _double = 0;
+#endif
+
+    void read_string();
+
+    void read_number();
+
+    void read_keyword();
+
+public:
+    Token token() { return _token; }
+
+    Reader(const char *buffer, size_t size);
+
+    Token next();
+
+    // Skips the rest of the object or array that was just entered.
+    void skip();
+
+    // The text of the current KEY or STRING token.
+    String string();
+
+    bool string_is(const char *string);
+
+    int integer();
+
+#ifndef __KERNEL__
+    double number();
+#endif
+
+    bool boolean();
+};
+
+} // namespace json
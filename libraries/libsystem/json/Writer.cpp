@@ -0,0 +1,155 @@
+#include <libsystem/Assert.h>
+#include <libsystem/core/CString.h>
+#include <libsystem/json/Writer.h>
+
+namespace json
+{
+
+void Writer::separator()
+{
+    if (_after_key)
+    {
+        _after_key = false;
+        return;
+    }
+
+    if (_has_elements & (1u << _depth))
+    {
+        _builder.append(',');
+    }
+
+    _has_elements |= 1u << _depth;
+}
+
+void Writer::begin(char chr)
+{
+    separator();
+    _builder.append(chr);
+
+    _depth++;
+    assert(_depth < MAX_DEPTH);
+
+    _has_elements &= ~(1u << _depth);
+}
+
+void Writer::end(char chr)
+{
+    assert(_depth > 0);
+
+    _depth--;
+    _builder.append(chr);
+}
+
+void Writer::string(const char *string, size_t length)
+{
+    _builder.append('"');
+
+    size_t start = 0;
+
+    for (size_t i = 0; i < length; i++)
+    {
+        char chr = string[i];
+
+        if (chr != '"' && chr != '\\' && (uint8_t)chr >= 0x20)
+        {
+            continue;
+        }
+
+        // Everything up to the escaped character is copied in one go.
+        _builder.append(string + start, i - start);
+        start = i + 1;
+
+        if (chr == '"' || chr == '\\')
+        {
+            _builder.append('\\');
+            _builder.append(chr);
+        }
+        else if (chr == '\n')
+        {
+            _builder.append("\\n");
+        }
+        else if (chr == '\t')
+        {
+            _builder.append("\\t");
+        }
+        else
+        {
+            const char *digits = "0123456789abcdef";
+
+            _builder.append("\\u00");
+            _builder.append(digits[(chr >> 4) & 0xf]);
+            _builder.append(digits[chr & 0xf]);
+        }
+    }
+
+    _builder.append(string + start, length - start);
+    _builder.append('"');
+}
+
+void Writer::key(const char *key)
+{
+    separator();
+
+    string(key, strlen(key));
+    _builder.append(':');
+
+    _after_key = true;
+}
+
+void Writer::value(const char *value)
+{
+    separator();
+
+    if (value)
+    {
+        string(value, strlen(value));
+    }
+    else
+    {
+        _builder.append("null");
+    }
+}
+
+void Writer::value(const String &value)
+{
+    separator();
+    string(value.cstring(), value.length());
+}
+
+void Writer::value(int value)
+{
+    separator();
+
+    // Digits are written backward from the end of the buffer.
+    char buffer[12];
+    size_t start = sizeof(buffer);
+
+    unsigned int digits = value < 0 ? -(unsigned int)value : value;
+
+    do
+    {
+        buffer[--start] = '0' + digits % 10;
+        digits /= 10;
+    } while (digits);
+
+    if (value < 0)
+    {
+        buffer[--start] = '-';
+    }
+
+    _builder.append(buffer + start, sizeof(buffer) - start);
+}
+
+void Writer::value(bool value)
+{
+    separator();
+    _builder.append(value ? "true" : "false");
+}
+
+void Writer::value(nullptr_t)
+{
+    separator();
+    _builder.append("null");
+}
+
+} // namespace json
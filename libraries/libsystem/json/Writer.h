@@ -0,0 +1,62 @@
+#pragma once
+
+#include <libutils/String.h>
+#include <libutils/StringBuilder.h>
+
+namespace json
+{
+
+// Writes a json document straight into a StringBuilder, without building
+// Values first. Commas and colons are taken care of.
+class Writer
+{
+private:
+    static constexpr int MAX_DEPTH = 32;
+
+    StringBuilder &_builder;
+
+    // One bit per nesting level, set once the container has an element.
+    uint32_t _has_elements = 0;
+    int _depth = 0;
+    bool _after_key = false;
+
+    void separator();
+
+    void begin(char chr);
+
+    void end(char chr);
+
+    void string(const char *string, size_t length);
+
+public:
+    Writer(StringBuilder &builder) : _builder(builder) {}
+
+    void begin_object() { begin('{'); }
+
+    void end_object() { end('}'); }
+
+    void begin_array() { begin('['); }
+
+    void end_array() { end(']'); }
+
+    void key(const char *key);
+
+    void value(const char *value);
+
+    void value(const String &value);
+
+    void value(int value);
+
+    void value(bool value);
+
+    void value(nullptr_t);
+
+    template <typename TValue>
+    void member(const char *key, TValue value)
+    {
+        this->key(key);
+        this->value(value);
+    }
+};
+
+} // namespace json
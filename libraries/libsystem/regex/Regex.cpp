@@ -0,0 +1,718 @@
+#include <libsystem/Assert.h>
+#include <libsystem/regex/Regex.h>
+
+// A set of NFA states, built the first time the search goes through it.
+struct RegexDFAState
+{
+    Vector<int> states;
+    uint32_t hash;
+
+    bool dead;
+    bool match;
+    bool match_at_end;
+
+    int next[256];
+};
+
+enum class RegexNodeType
+{
+    EMPTY,
+    BYTES,
+    BEGIN,
+    END,
+    CONCAT,
+    ALTERNATE,
+    STAR,
+    PLUS,
+    QUESTION,
+};
+
+struct RegexNode
+{
+    RegexNodeType type;
+    int set;
+    int left;
+    int right;
+};
+
+struct RegexCompiler
+{
+    Regex &regex;
+    const char *pattern;
+
+    Vector<RegexNode> nodes{};
+    bool error = false;
+
+    RegexCompiler(Regex &regex, const char *pattern)
+        : regex(regex), pattern(pattern)
+    {
+    }
+
+    bool ended() { return *pattern == '\0'; }
+
+    char current() { return *pattern; }
+
+    char next() { return ended() ? '\0' : *pattern++; }
+
+    int node(RegexNodeType type, int set = -1, int left = -1, int right = -1)
+    {
+        nodes.push_back({type, set, left, right});
+        return nodes.count() - 1;
+    }
+
+    int set(RegexSet set)
+    {
+        regex._sets.push_back(set);
+        return regex._sets.count() - 1;
+    }
+
+    static RegexSet range(uint8_t from, uint8_t to)
+    {
+        RegexSet set = {};
+
+        for (int byte = from; byte <= to; byte++)
+        {
+            set.add(byte);
+        }
+
+        return set;
+    }
+
+    static RegexSet merged(RegexSet left, RegexSet right)
+    {
+        for (int i = 0; i < 8; i++)
+        {
+            left.bits[i] |= right.bits[i];
+        }
+
+        return left;
+    }
+
+    static RegexSet inverted(RegexSet set)
+    {
+        for (int i = 0; i < 8; i++)
+        {
+            set.bits[i] = ~set.bits[i];
+        }
+
+        return set;
+    }
+
+    // \d \w \s and their negations, or just the escaped byte.
+    RegexSet escape()
+    {
+        char c = next();
+
+        switch (c)
+        {
+        case 'd':
+            return range('0', '9');
+
+        case 'D':
+            return inverted(range('0', '9'));
+
+        case 'w':
+            return merged(merged(range('a', 'z'), range('A', 'Z')), merged(range('0', '9'), range('_', '_')));
+
+        case 'W':
+            return inverted(merged(merged(range('a', 'z'), range('A', 'Z')), merged(range('0', '9'), range('_', '_'))));
+
+        case 's':
+            return merged(range(' ', ' '), range('\t', '\r'));
+
+        case 'S':
+            return inverted(merged(range(' ', ' '), range('\t', '\r')));
+
+        case 'n':
+            return range('\n', '\n');
+
+        case 't':
+            return range('\t', '\t');
+
+        case '\0':
+            error = true;
+            return {};
+
+        default:
+            return range(c, c);
+        }
+    }
+
+    RegexSet klass()
+    {
+        bool negated = false;
+
+        if (current() == '^')
+        {
+            next();
+            negated = true;
+        }
+
+        RegexSet set = {};
+        bool first = true;
+
+        while (!ended() && (current() != ']' || first))
+        {
+            first = false;
+
+            char c = next();
+
+            if (c == '\\')
+            {
+                set = merged(set, escape());
+            }
+            else if (current() == '-' && pattern[1] != ']' && pattern[1] != '\0')
+            {
+                next();
+                char to = next();
+
+                if ((uint8_t)to < (uint8_t)c)
+                {
+                    error = true;
+                }
+
+                set = merged(set, range(c, to));
+            }
+            else
+            {
+                set.add(c);
+            }
+        }
+
+        if (next() != ']')
+        {
+            error = true;
+        }
+
+        return negated ? inverted(set) : set;
+    }
+
+    int atom()
+    {
+        char c = next();
+
+        switch (c)
+        {
+        case '(':
+        {
+            int inner = alternation();
+
+            if (next() != ')')
+            {
+                error = true;
+            }
+
+            return inner;
+        }
+
+        case '[':
+            return node(RegexNodeType::BYTES, set(klass()));
+
+        case '.':
+            // Lines are matched one by one, so there is no point in excluding '\n'.
+            return node(RegexNodeType::BYTES, set(range(0, 255)));
+
+        case '^':
+            return node(RegexNodeType::BEGIN);
+
+        case '$':
+            return node(RegexNodeType::END);
+
+        case '\\':
+            return node(RegexNodeType::BYTES, set(escape()));
+
+        case '*':
+        case '+':
+        case '?':
+            // Nothing to repeat.
+            error = true;
+            return node(RegexNodeType::EMPTY);
+
+        default:
+            return node(RegexNodeType::BYTES, set(range(c, c)));
+        }
+    }
+
+    int repetition()
+    {
+        int inner = atom();
+
+        while (current() == '*' || current() == '+' || current() == '?')
+        {
+            char c = next();
+
+            if (c == '*')
+            {
+                inner = node(RegexNodeType::STAR, -1, inner);
+            }
+            else if (c == '+')
+            {
+                inner = node(RegexNodeType::PLUS, -1, inner);
+            }
+            else
+            {
+                inner = node(RegexNodeType::QUESTION, -1, inner);
+            }
+        }
+
+        return inner;
+    }
+
+    int concatenation()
+    {
+        int left = node(RegexNodeType::EMPTY);
+
+        while (!ended() && current() != '|' && current() != ')')
+        {
+            int right = repetition();
+
+            if (nodes[left].type == RegexNodeType::EMPTY)
+            {
+                left = right;
+            }
+            else
+            {
+                left = node(RegexNodeType::CONCAT, -1, left, right);
+            }
+        }
+
+        return left;
+    }
+
+    int alternation()
+    {
+        int left = concatenation();
+
+        while (current() == '|')
+        {
+            next();
+
+            int right = concatenation();
+            left = node(RegexNodeType::ALTERNATE, -1, left, right);
+        }
+
+        return left;
+    }
+
+    int state(RegexOperation operation, int set, int out, int out1)
+    {
+        regex._states.push_back({operation, set, out, out1});
+        return regex._states.count() - 1;
+    }
+
+    // Compiled back to front, so each fragment already knows where it goes next.
+    int compile(int index, int out)
+    {
+        RegexNode node = nodes[index];
+
+        switch (node.type)
+        {
+        case RegexNodeType::EMPTY:
+            return out;
+
+        case RegexNodeType::BYTES:
+            return state(RegexOperation::BYTES, node.set, out, -1);
+
+        case RegexNodeType::BEGIN:
+            return state(RegexOperation::BEGIN, -1, out, -1);
+
+        case RegexNodeType::END:
+            return state(RegexOperation::END, -1, out, -1);
+
+        case RegexNodeType::CONCAT:
+            return compile(node.left, compile(node.right, out));
+
+        case RegexNodeType::ALTERNATE:
+        {
+            int left = compile(node.left, out);
+            int right = compile(node.right, out);
+
+            return state(RegexOperation::SPLIT, -1, left, right);
+        }
+
+        case RegexNodeType::STAR:
+        {
+            int split = state(RegexOperation::SPLIT, -1, -1, out);
+            regex._states[split].out = compile(node.left, split);
+
+            return split;
+        }
+
+        case RegexNodeType::PLUS:
+        {
+            int split = state(RegexOperation::SPLIT, -1, -1, out);
+            int body = compile(node.left, split);
+            regex._states[split].out = body;
+
+            return body;
+        }
+
+        case RegexNodeType::QUESTION:
+            return state(RegexOperation::SPLIT, -1, compile(node.left, out), out);
+
+        default:
+            ASSERT_NOT_REACHED();
+        }
+    }
+
+    static bool single_byte(RegexSet &set, char *byte)
+    {
+        int count = 0;
+
+        for (int i = 0; i < 256; i++)
+        {
+            if (set.contains(i))
+            {
+                *byte = i;
+                count++;
+            }
+        }
+
+        return count == 1;
+    }
+
+    // Collect the literal bytes at the start of the pattern.
+    bool prefix(int index)
+    {
+        RegexNode &node = nodes[index];
+
+        if (node.type == RegexNodeType::CONCAT)
+        {
+            return prefix(node.left) && prefix(node.right);
+        }
+
+        if (node.type == RegexNodeType::BEGIN && regex._prefix.empty())
+        {
+            regex._anchored = true;
+            return true;
+        }
+
+        char byte;
+
+        if (node.type == RegexNodeType::BYTES && single_byte(regex._sets[node.set], &byte))
+        {
+            regex._prefix.push_back(byte);
+            return true;
+        }
+
+        return false;
+    }
+};
+
+ResultOr<OwnPtr<Regex>> Regex::compile(const char *pattern)
+{
+    auto regex = own<Regex>();
+
+    RegexCompiler compiler{*regex, pattern};
+
+    int root = compiler.alternation();
+
+    if (compiler.error || !compiler.ended())
+    {
+        return ERR_INVALID_ARGUMENT;
+    }
+
+    int match = compiler.state(RegexOperation::MATCH, -1, -1, -1);
+    regex->_start = compiler.compile(root, match);
+
+    compiler.prefix(root);
+
+    for (size_t i = 0; i < regex->_states.count(); i++)
+    {
+        regex->_marks.push_back(-1);
+    }
+
+    return regex;
+}
+
+Regex::Regex()
+{
+}
+
+Regex::~Regex()
+{
+    flush();
+}
+
+void Regex::closure(Vector<int> &states, int state, bool at_begin)
+{
+    if (state < 0 || _marks[state] == _generation)
+    {
+        return;
+    }
+
+    _marks[state] = _generation;
+
+    RegexState &current = _states[state];
+
+    switch (current.operation)
+    {
+    case RegexOperation::SPLIT:
+        closure(states, current.out, at_begin);
+        closure(states, current.out1, at_begin);
+        break;
+
+    case RegexOperation::BEGIN:
+        if (at_begin)
+        {
+            closure(states, current.out, at_begin);
+        }
+        break;
+
+    default:
+        states.push_back(state);
+        break;
+    }
+}
+
+bool Regex::match_at_end(Vector<int> &states)
+{
+    _generation++;
+
+    Vector<int> reached{};
+
+    for (size_t i = 0; i < states.count(); i++)
+    {
+        if (_states[states[i]].operation == RegexOperation::END)
+        {
+            closure(reached, _states[states[i]].out, false);
+        }
+    }
+
+    // There could be more than one $ in a row.
+    for (size_t i = 0; i < reached.count(); i++)
+    {
+        if (_states[reached[i]].operation == RegexOperation::MATCH)
+        {
+            return true;
+        }
+
+        if (_states[reached[i]].operation == RegexOperation::END)
+        {
+            closure(reached, _states[reached[i]].out, false);
+        }
+    }
+
+    return false;
+}
+
+void Regex::flush()
+{
+    for (size_t i = 0; i < _dfa.count(); i++)
+    {
+        delete _dfa[i];
+    }
+
+    _dfa.clear();
+    _flushes++;
+}
+
+int Regex::intern(Vector<int> &states)
+{
+    for (size_t i = 1; i < states.count(); i++)
+    {
+        for (size_t j = i; j > 0 && states[j - 1] > states[j]; j--)
+        {
+            swap(states[j - 1], states[j]);
+        }
+    }
+
+    uint32_t hash = 2166136261u;
+
+    for (size_t i = 0; i < states.count(); i++)
+    {
+        hash = (hash ^ states[i]) * 16777619u;
+    }
+
+    for (size_t i = 0; i < _dfa.count(); i++)
+    {
+        RegexDFAState *dfa = _dfa[i];
+
+        if (dfa->hash != hash || dfa->states.count() != states.count())
+        {
+            continue;
+        }
+
+        bool equal = true;
+
+        for (size_t j = 0; j < states.count() && equal; j++)
+        {
+            equal = dfa->states[j] == states[j];
+        }
+
+        if (equal)
+        {
+            return i;
+        }
+    }
+
+    // Pathological patterns could build a lot of states, start over instead.
+    if (_dfa.count() >= REGEX_DFA_MAX_STATES)
+    {
+        flush();
+    }
+
+    auto *dfa = new RegexDFAState{};
+
+    dfa->hash = hash;
+    dfa->dead = states.empty();
+    dfa->match = false;
+
+    for (size_t i = 0; i < states.count(); i++)
+    {
+        dfa->match |= _states[states[i]].operation == RegexOperation::MATCH;
+    }
+
+    dfa->match_at_end = dfa->match || match_at_end(states);
+
+    for (int i = 0; i < 256; i++)
+    {
+        dfa->next[i] = -1;
+    }
+
+    dfa->states = move(states);
+
+    _dfa.push_back(dfa);
+
+    return _dfa.count() - 1;
+}
+
+int Regex::start_state(bool at_begin)
+{
+    if (_starts_flushes != _flushes)
+    {
+        Vector<int> states{};
+        _generation++;
+        closure(states, _start, true);
+        _starts[true] = intern(states);
+
+        Vector<int> restart{};
+        _generation++;
+        closure(restart, _start, false);
+        int flushes = _flushes;
+        _starts[false] = intern(restart);
+
+        if (flushes != _flushes)
+        {
+            // The cache was just flushed under our feet, try again.
+            return start_state(at_begin);
+        }
+
+        _starts_flushes = _flushes;
+    }
+
+    return _starts[at_begin];
+}
+
+int Regex::next_state(int current, uint8_t byte)
+{
+    Vector<int> states{};
+
+    _generation++;
+
+    RegexDFAState *dfa = _dfa[current];
+
+    for (size_t i = 0; i < dfa->states.count(); i++)
+    {
+        RegexState &state = _states[dfa->states[i]];
+
+        if (state.operation == RegexOperation::BYTES && _sets[state.set].contains(byte))
+        {
+            closure(states, state.out, false);
+        }
+    }
+
+    // A match can start anywhere, not only where the search started.
+    closure(states, _start, false);
+
+    int flushes = _flushes;
+    int next = intern(states);
+
+    if (flushes == _flushes)
+    {
+        dfa->next[byte] = next;
+    }
+
+    return next;
+}
+
+const char *Regex::candidate(const char *text, size_t size)
+{
+    size_t length = _prefix.count();
+
+    if (_anchored)
+    {
+        if (size >= length && memcmp(text, _prefix.raw_storage(), length) == 0)
+        {
+            return text;
+        }
+
+        return nullptr;
+    }
+
+    if (length == 0)
+    {
+        return text;
+    }
+
+    const char *current = text;
+    const char *end = text + size;
+
+    while ((size_t)(end - current) >= length)
+    {
+        current = (const char *)memchr(current, _prefix[0], end - current - length + 1);
+
+        if (!current)
+        {
+            return nullptr;
+        }
+
+        if (memcmp(current, _prefix.raw_storage(), length) == 0)
+        {
+            return current;
+        }
+
+        current++;
+    }
+
+    return nullptr;
+}
+
+bool Regex::match(const char *text, size_t size)
+{
+    const char *start = candidate(text, size);
+
+    if (!start)
+    {
+        return false;
+    }
+
+    int current = start_state(start == text);
+    const char *end = text + size;
+
+    for (const char *c = start; c < end; c++)
+    {
+        RegexDFAState *dfa = _dfa[current];
+
+        if (dfa->match)
+        {
+            return true;
+        }
+
+        if (dfa->dead)
+        {
+            return false;
+        }
+
+        int next = dfa->next[(uint8_t)*c];
+
+        if (next < 0)
+        {
+            next = next_state(current, *c);
+        }
+
+        current = next;
+    }
+
+    return _dfa[current]->match_at_end;
+}
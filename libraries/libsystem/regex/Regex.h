@@ -0,0 +1,95 @@
+#pragma once
+
+#include <libsystem/core/CString.h>
+#include <libutils/OwnPtr.h>
+#include <libutils/ResultOr.h>
+#include <libutils/Vector.h>
+
+#define REGEX_DFA_MAX_STATES 256
+
+enum class RegexOperation : uint8_t
+{
+    BYTES,
+    SPLIT,
+    BEGIN,
+    END,
+    MATCH,
+};
+
+struct RegexSet
+{
+    uint32_t bits[8];
+
+    bool contains(uint8_t byte) const { return bits[byte / 32] & (1u << (byte % 32)); }
+
+    void add(uint8_t byte) { bits[byte / 32] |= 1u << (byte % 32); }
+};
+
+// A state of the Thompson NFA, out1 is only used by SPLIT.
+struct RegexState
+{
+    RegexOperation operation;
+    int set;
+    int out;
+    int out1;
+};
+
+struct RegexDFAState;
+
+// Byte oriented regular expressions: . [] [^] * + ? | () ^ $ and the \d \w \s classes.
+// Patterns are compiled to an NFA, which is turned into a DFA lazily
+// while searching, so matching is linear in the size of the text.
+class Regex
+{
+private:
+    Vector<RegexSet> _sets{};
+    Vector<RegexState> _states{};
+    int _start = 0;
+
+    // Bytes every match starts with, used to skip ahead with memchr.
+    Vector<char> _prefix{};
+    bool _anchored = false;
+
+    Vector<RegexDFAState *> _dfa{};
+    Vector<int> _marks{};
+    int _generation = 0;
+    int _flushes = 0;
+
+    int _starts[2] = {};
+    int _starts_flushes = -1;
+
+    void closure(Vector<int> &states, int state, bool at_begin);
+
+    bool match_at_end(Vector<int> &states);
+
+    int intern(Vector<int> &states);
+
+    int start_state(bool at_begin);
+
+    int next_state(int current, uint8_t byte);
+
+    void flush();
+
+public:
+    int state_count() { return _states.count(); }
+
+    int dfa_state_count() { return _dfa.count(); }
+
+    bool anchored() { return _anchored; }
+
+    static ResultOr<OwnPtr<Regex>> compile(const char *pattern);
+
+    Regex();
+
+    ~Regex();
+
+    // The first place a match could start, or nullptr if there can't be one.
+    const char *candidate(const char *text, size_t size);
+
+    // Does the pattern match anywhere in the text, ^ and $ being its ends.
+    bool match(const char *text, size_t size);
+
+    bool match(const char *text) { return match(text, strlen(text)); }
+
+    friend struct RegexCompiler;
+};
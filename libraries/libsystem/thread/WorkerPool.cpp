@@ -0,0 +1,21 @@
+#include <libsystem/math/MinMax.h>
+#include <libsystem/thread/WorkerPool.h>
+
+WorkerPool::WorkerPool(size_t worker_count)
+    : _worker_count(MAX(worker_count, 1))
+{
+}
+
+void WorkerPool::run(size_t job_count, Callback<void(size_t job, size_t worker)> job)
+{
+    // hjert doesn't run tasks sharing an address space on other processors
+    // yet, so the workers take turns on the calling thread. Jobs are still
+    // dealt round-robin, the same way concurrent workers would get them.
+    for (size_t worker = 0; worker < _worker_count; worker++)
+    {
+        for (size_t index = worker; index < job_count; index += _worker_count)
+        {
+            job(index, worker);
+        }
+    }
+}
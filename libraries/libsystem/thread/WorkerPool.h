@@ -0,0 +1,20 @@
+#pragma once
+
+#include <libsystem/Common.h>
+#include <libutils/Callback.h>
+
+class WorkerPool
+{
+private:
+    size_t _worker_count;
+
+public:
+    size_t worker_count() { return _worker_count; }
+
+    WorkerPool(size_t worker_count);
+
+    // Call job(index, worker) for every index in [0, job_count) and
+    // return once all of them are done. A worker never runs two jobs at
+    // the same time, so per-worker state can be indexed by `worker`.
+    void run(size_t job_count, Callback<void(size_t job, size_t worker)> job);
+};
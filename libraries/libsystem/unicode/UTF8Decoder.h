@@ -13,6 +13,8 @@ private:
     Callback<void(Codepoint)> _callback{};
 
 public:
+    bool decoding() const { return _decoding; }
+
     void callback(Callback<void(Codepoint)> callback)
     {
         _callback = callback;
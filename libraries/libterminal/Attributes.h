@@ -6,14 +6,15 @@
 namespace terminal
 {
 
+// Packed in three bytes, the colors are indexes in the theme palette.
 struct Attributes
 {
-    Color foreground;
-    Color background;
+    Color foreground : 5;
+    Color background : 5;
 
-    bool bold;
-    bool invert;
-    bool underline;
+    bool bold : 1;
+    bool invert : 1;
+    bool underline : 1;
 
     static Attributes defaults()
     {
@@ -9,7 +9,8 @@ struct Cell
 {
     Codepoint codepoint;
     Attributes attributes;
-    bool dirty;
 };
 
+static_assert(sizeof(Cell) == 8);
+
 } // namespace terminal
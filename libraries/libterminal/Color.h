@@ -1,9 +1,11 @@
 #pragma once
 
+#include <libsystem/Common.h>
+
 namespace terminal
 {
 
-enum Color
+enum Color : uint8_t
 {
     BLACK,
     RED,
@@ -0,0 +1,137 @@
+#include <libsystem/Assert.h>
+#include <libsystem/core/CString.h>
+#include <libterminal/Scrollback.h>
+
+namespace terminal
+{
+
+struct ScrollbackLine
+{
+    int runs_count;
+    int size;
+
+    ScrollbackRun *runs() { return reinterpret_cast<ScrollbackRun *>(this + 1); }
+
+    uint8_t *utf8() { return reinterpret_cast<uint8_t *>(runs() + runs_count); }
+};
+
+Scrollback::Scrollback(int capacity)
+{
+    _capacity = capacity;
+    _count = 0;
+    _oldest = 0;
+    _pushed = 0;
+    _lines = (uint8_t **)calloc(capacity, sizeof(uint8_t *));
+}
+
+Scrollback::~Scrollback()
+{
+    clear();
+    free(_lines);
+}
+
+void Scrollback::clear()
+{
+    for (int i = 0; i < _count; i++)
+    {
+        free(_lines[(_oldest + i) % _capacity]);
+    }
+
+    _count = 0;
+    _oldest = 0;
+}
+
+void Scrollback::push(const Cell *cells, int width)
+{
+    if (_capacity == 0)
+    {
+        return;
+    }
+
+    int length = width;
+
+    while (length > 0 &&
+           cells[length - 1].codepoint == U' ' &&
+           cells[length - 1].attributes == Attributes::defaults())
+    {
+        length--;
+    }
+
+    int runs_count = 0;
+    int size = 0;
+
+    for (int i = 0; i < length; i++)
+    {
+        if (i == 0 || cells[i].attributes != cells[i - 1].attributes)
+        {
+            runs_count++;
+        }
+
+        uint8_t utf8[5];
+        size += codepoint_to_utf8(cells[i].codepoint, utf8);
+    }
+
+    // One more byte for the nul codepoint_to_utf8 puts after the last codepoint.
+    auto *line = (ScrollbackLine *)malloc(sizeof(ScrollbackLine) + sizeof(ScrollbackRun) * runs_count + size + 1);
+
+    line->runs_count = 0;
+    line->size = size;
+
+    uint8_t *utf8 = reinterpret_cast<uint8_t *>(line->runs() + runs_count);
+
+    for (int i = 0; i < length; i++)
+    {
+        if (i == 0 || cells[i].attributes != cells[i - 1].attributes)
+        {
+            line->runs()[line->runs_count++] = {cells[i].attributes, 0};
+        }
+
+        line->runs()[line->runs_count - 1].length++;
+        utf8 += codepoint_to_utf8(cells[i].codepoint, utf8);
+    }
+
+    if (_count == _capacity)
+    {
+        free(_lines[_oldest]);
+        _lines[_oldest] = (uint8_t *)line;
+        _oldest = (_oldest + 1) % _capacity;
+    }
+    else
+    {
+        _lines[(_oldest + _count) % _capacity] = (uint8_t *)line;
+        _count++;
+    }
+
+    _pushed++;
+}
+
+void Scrollback::line(int index, Cell *cells, int width)
+{
+    assert(index >= 0 && index < _count);
+
+    auto *line = (ScrollbackLine *)_lines[(_oldest + index) % _capacity];
+
+    const uint8_t *utf8 = line->utf8();
+    int x = 0;
+
+    for (int run = 0; run < line->runs_count; run++)
+    {
+        for (int i = 0; i < line->runs()[run].length; i++)
+        {
+            Codepoint codepoint = 0;
+            utf8 += utf8_to_codepoint(utf8, &codepoint);
+
+            if (x < width)
+            {
+                cells[x++] = {codepoint, line->runs()[run].attributes};
+            }
+        }
+    }
+
+    for (; x < width; x++)
+    {
+        cells[x] = {U' ', Attributes::defaults()};
+    }
+}
+
+} // namespace terminal
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <libterminal/Cell.h>
+
+namespace terminal
+{
+
+struct ScrollbackRun
+{
+    Attributes attributes;
+    int length;
+};
+
+// Lines that went past the top of the screen, oldest first.
+// Trailing blanks are dropped, codepoints are stored as utf8 and the
+// attributes as runs, so a line of plain text costs about its length in bytes.
+struct Scrollback
+{
+private:
+    uint8_t **_lines;
+    int _capacity;
+    int _count;
+    int _oldest;
+    size_t _pushed;
+
+public:
+    int count() { return _count; }
+
+    // Lines pushed since the scrollback was created, even the ones that were dropped since.
+    size_t pushed() { return _pushed; }
+
+    int capacity() { return _capacity; }
+
+    Scrollback(int capacity);
+
+    ~Scrollback();
+
+    void clear();
+
+    void push(const Cell *cells, int width);
+
+    // Decode a line into width cells, padded with blanks of the default attributes.
+    void line(int index, Cell *cells, int width);
+};
+
+} // namespace terminal
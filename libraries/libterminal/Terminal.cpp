@@ -1,19 +1,25 @@
 
 #include <libsystem/Assert.h>
+#include <libsystem/core/CString.h>
 #include <libsystem/math/MinMax.h>
 #include <libterminal/Terminal.h>
 
 namespace terminal
 {
 
-Terminal::Terminal(int width, int height)
+Terminal::Terminal(int width, int height, int scrollback)
+    : _scrollback(scrollback)
 {
     _width = width;
     _height = height;
     _buffer = (Cell *)calloc(_width * _height, sizeof(Cell));
+    _top = 0;
+    _dirty = (uint32_t *)calloc((_height + 31) / 32, sizeof(uint32_t));
 
     _decoder.callback([this](auto codepoint) { write(codepoint); });
 
+    _state = State::WAIT_ESC;
+
     _cursor = {0, 0, true};
     _saved_cursor = {0, 0, true};
 
@@ -33,13 +39,14 @@ Terminal::Terminal(int width, int height)
 Terminal::~Terminal()
 {
     free(_buffer);
+    free(_dirty);
 }
 
 void Terminal::clear(int fromx, int fromy, int tox, int toy)
 {
     for (int i = fromx + fromy * _width; i < tox + toy * _width; i++)
     {
-        set_cell(i % _width, i / _width, (Cell){U' ', _attributes, true});
+        set_cell(i % _width, i / _width, (Cell){U' ', _attributes});
     }
 }
 
@@ -54,7 +61,7 @@ void Terminal::clear_line(int line)
     {
         for (int i = 0; i < _width; i++)
         {
-            set_cell(i, line, (Cell){U' ', _attributes, true});
+            set_cell(i, line, (Cell){U' ', _attributes});
         }
     }
 }
@@ -65,7 +72,7 @@ void Terminal::resize(int width, int height)
 
     for (int i = 0; i < width * height; i++)
     {
-        new_buffer[i] = {U' ', _attributes, true};
+        new_buffer[i] = {U' ', _attributes};
     }
 
     for (int x = 0; x < MIN(width, _width); x++)
@@ -78,10 +85,16 @@ void Terminal::resize(int width, int height)
 
     free(_buffer);
     _buffer = new_buffer;
+    _top = 0;
+
+    free(_dirty);
+    _dirty = (uint32_t *)calloc((height + 31) / 32, sizeof(uint32_t));
 
     _width = width;
     _height = height;
 
+    mark_all_lines_dirty();
+
     _cursor.x = clamp(_cursor.x, 0, width - 1);
     _cursor.y = clamp(_cursor.y, 0, height - 1);
 }
@@ -90,17 +103,34 @@ Cell Terminal::cell_at(int x, int y)
 {
     if (x >= 0 && x < _width && y >= 0 && y < _height)
     {
-        return _buffer[y * _width + x];
+        return line(y)[x];
     }
 
-    return {U' ', _attributes, true};
+    return {U' ', _attributes};
 }
 
-void Terminal::cell_undirty(int x, int y)
+const Cell *Terminal::line_at(int y)
 {
-    if (x >= 0 && x < _width && y >= 0 && y < _height)
+    assert(y >= 0 && y < _height);
+
+    return line(y);
+}
+
+bool Terminal::line_dirty(int y)
+{
+    if (y >= 0 && y < _height)
     {
-        _buffer[y * _width + x].dirty = false;
+        return _dirty[y / 32] & (1u << (y % 32));
+    }
+
+    return false;
+}
+
+void Terminal::line_undirty(int y)
+{
+    if (y >= 0 && y < _height)
+    {
+        _dirty[y / 32] &= ~(1u << (y % 32));
     }
 }
 
@@ -109,13 +139,13 @@ void Terminal::set_cell(int x, int y, Cell cell)
     if (x >= 0 && x < _width &&
         y >= 0 && y < _height)
     {
-        Cell old_cell = _buffer[y * _width + x];
+        Cell &old_cell = line(y)[x];
 
         if (old_cell.codepoint != cell.codepoint ||
             old_cell.attributes != cell.attributes)
         {
-            _buffer[y * _width + x] = cell;
-            _buffer[y * _width + x].dirty = true;
+            old_cell = cell;
+            mark_line_dirty(y);
         }
     }
 }
@@ -160,41 +190,43 @@ void Terminal::cursor_move(int offx, int offy)
 
 void Terminal::cursor_set(int x, int y)
 {
-    _cursor.x = clamp(x, 0, _width);
-    _cursor.y = clamp(y, 0, _height);
+    _cursor.x = clamp(x, 0, _width - 1);
+    _cursor.y = clamp(y, 0, _height - 1);
+}
+
+void Terminal::mark_all_lines_dirty()
+{
+    for (int i = 0; i < _height; i++)
+    {
+        mark_line_dirty(i);
+    }
 }
 
 void Terminal::scroll(int how_many_line)
 {
+    // Scrolling only rotates the ring, the lines coming in are the ones
+    // that went out on the other side and get cleared.
     if (how_many_line < 0)
     {
-        for (int line = 0; line < how_many_line; line++)
+        for (int i = 0; i < MIN(-how_many_line, _height); i++)
         {
-            for (int i = (_width * _height) - 1; i >= _height; i++)
-            {
-                int x = i % _width;
-                int y = i / _width;
-
-                set_cell(x, y, cell_at(x, y - 1));
-            }
-
+            _top = (_top + _height - 1) % _height;
             clear_line(0);
         }
+
+        mark_all_lines_dirty();
     }
     else if (how_many_line > 0)
     {
-        for (int line = 0; line < how_many_line; line++)
+        for (int i = 0; i < MIN(how_many_line, _height); i++)
         {
-            for (int i = 0; i < _width * (_height - 1); i++)
-            {
-                int x = i % _width;
-                int y = i / _width;
-
-                set_cell(x, y, cell_at(x, y + 1));
-            }
+            _scrollback.push(line(0), _width);
 
+            _top = (_top + 1) % _height;
             clear_line(_height - 1);
         }
+
+        mark_all_lines_dirty();
     }
 }
 
@@ -228,7 +260,42 @@ void Terminal::append(Codepoint codepoint)
     }
     else
     {
-        set_cell(_cursor.x, _cursor.y, {codepoint, _attributes, true});
+        set_cell(_cursor.x, _cursor.y, {codepoint, _attributes});
+        cursor_move(1, 0);
+    }
+}
+
+void Terminal::append_ascii(const char *text, size_t length)
+{
+    while (length > 0)
+    {
+        int count = MIN((int)length, _width - _cursor.x);
+
+        Cell *cells = line(_cursor.y) + _cursor.x;
+        bool changed = false;
+
+        for (int i = 0; i < count; i++)
+        {
+            Cell cell = {(Codepoint)text[i], _attributes};
+
+            if (cells[i].codepoint != cell.codepoint ||
+                cells[i].attributes != cell.attributes)
+            {
+                cells[i] = cell;
+                changed = true;
+            }
+        }
+
+        if (changed)
+        {
+            mark_line_dirty(_cursor.y);
+        }
+
+        text += count;
+        length -= count;
+
+        // The last one goes through cursor_move() like append() to wrap and scroll the same way.
+        _cursor.x += count - 1;
         cursor_move(1, 0);
     }
 }
@@ -526,11 +593,68 @@ void Terminal::write(char c)
     _decoder.write(c);
 }
 
+// Bytes between ' ' and '~' are printed as they are, everything else
+// (controls, escapes and utf8 sequences) goes through the state machine.
+static bool is_printable_ascii(char c)
+{
+    return c >= ' ' && c <= '~';
+}
+
+// Four bytes at the time, true if all of them are printable.
+static bool is_printable_ascii(uint32_t word)
+{
+    uint32_t below_space = (word - 0x20202020) & ~word & 0x80808080;
+    uint32_t above_tilde = ((word + 0x01010101) | word) & 0x80808080;
+
+    return (below_space | above_tilde) == 0;
+}
+
+static size_t printable_ascii_run(const char *buffer, size_t size)
+{
+    size_t length = 0;
+
+    while (length + 4 <= size)
+    {
+        uint32_t word;
+        memcpy(&word, buffer + length, 4);
+
+        if (!is_printable_ascii(word))
+        {
+            break;
+        }
+
+        length += 4;
+    }
+
+    while (length < size && is_printable_ascii(buffer[length]))
+    {
+        length++;
+    }
+
+    return length;
+}
+
 void Terminal::write(const char *buffer, size_t size)
 {
-    for (size_t i = 0; i < size; i++)
+    size_t i = 0;
+
+    while (i < size)
     {
+        if (_state == State::WAIT_ESC && !_decoder.decoding())
+        {
+            size_t length = printable_ascii_run(buffer + i, size - i);
+
+            if (length > 0)
+            {
+                append_ascii(buffer + i, length);
+                i += length;
+
+                continue;
+            }
+        }
+
         write(buffer[i]);
+        i++;
     }
 }
 
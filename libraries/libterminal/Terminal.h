@@ -4,6 +4,7 @@
 #include <libterminal/Attributes.h>
 #include <libterminal/Cell.h>
 #include <libterminal/Cursor.h>
+#include <libterminal/Scrollback.h>
 
 namespace terminal
 {
@@ -26,7 +27,15 @@ struct Terminal
 private:
     int _height;
     int _width;
+
+    // The screen is a ring of lines, _top is the one displayed first.
     Cell *_buffer;
+    int _top;
+
+    // One bit per line of the screen, set when the line has to be painted again.
+    uint32_t *_dirty;
+
+    Scrollback _scrollback;
     UTF8Decoder _decoder;
 
     State _state;
@@ -39,14 +48,26 @@ private:
     int _parameters_top;
     Parameter _parameters[MAX_PARAMETERS];
 
+    Cell *line(int y) { return &_buffer[((_top + y) % _height) * _width]; }
+
+    void mark_line_dirty(int y) { _dirty[y / 32] |= 1u << (y % 32); }
+
+    void mark_all_lines_dirty();
+
+    void append_ascii(const char *text, size_t length);
+
 public:
+    static constexpr int DEFAULT_SCROLLBACK = 1000;
+
     int width() { return _width; }
 
     int height() { return _height; }
 
     const Cursor &cursor() { return _cursor; }
 
-    Terminal(int width, int height);
+    Scrollback &scrollback() { return _scrollback; }
+
+    Terminal(int width, int height, int scrollback = DEFAULT_SCROLLBACK);
 
     ~Terminal();
 
@@ -60,7 +81,11 @@ public:
 
     Cell cell_at(int x, int y);
 
-    void cell_undirty(int x, int y);
+    const Cell *line_at(int y);
+
+    bool line_dirty(int y);
+
+    void line_undirty(int y);
 
     void set_cell(int x, int y, Cell cell);
 
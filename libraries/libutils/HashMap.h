@@ -4,6 +4,10 @@
 #include <libutils/Hash.h>
 #include <libutils/Vector.h>
 
+// Open addressing with robin hood hashing: items are placed at the first free
+// slot after the one their hash maps to, taking the place of any item closer to its own
+// ideal slot. Probe sequences stay short and lookups stop as soon as they
+// meet an item closer to home than the key would be.
 template <typename TKey, typename TValue>
 class HashMap
 {
@@ -15,97 +19,254 @@ private:
         TValue value;
     };
 
-    static constexpr int BUCKET_COUNT = 256;
+    static constexpr size_t MIN_CAPACITY = 8;
 
-    Vector<Vector<Item>> _buckets{};
+    // Only the slots with a distance are constructed.
+    Item *_items = nullptr;
 
-    Vector<Item> &bucket(uint32_t hash)
+    // How far each item is from its ideal slot plus one, 0 for empty slots.
+    uint32_t *_distances = nullptr;
+
+    size_t _capacity = 0;
+    size_t _count = 0;
+    int _shift = 32;
+
+    // Similar keys tend to have similar hashes, fibonacci hashing
+    // spreads them over the table instead of using the low bits as is.
+    size_t ideal_slot(uint32_t hash) const
     {
-        return _buckets[hash % BUCKET_COUNT];
+        return (uint32_t)(hash * 2654435769u) >> _shift;
     }
 
-    Item *item_by_key(const TKey &key)
+    // Strings can be looked up by const char * without building a String first.
+    template <typename TLookup>
+    static uint32_t lookup_hash(const TLookup &key)
     {
-        return item_by_key(key, hash<TKey>(key));
+        if constexpr (std::is_convertible_v<const TLookup &, const char *>)
+        {
+            return hash(key, strlen(key));
+        }
+        else
+        {
+            return hash<TKey>(key);
+        }
     }
 
-    Item *item_by_key(const TKey &key, uint32_t hash)
+    template <typename TLookup>
+    Item *item_by_key(const TLookup &key) const
     {
-        Item *result = nullptr;
-        auto &b = bucket(hash);
+        return item_by_key(key, lookup_hash(key));
+    }
+
+    template <typename TLookup>
+    Item *item_by_key(const TLookup &key, uint32_t hash) const
+    {
+        if (_count == 0)
+        {
+            return nullptr;
+        }
+
+        size_t mask = _capacity - 1;
+        size_t slot = ideal_slot(hash);
 
-        b.foreach ([&](Item &item) {
-            if (item.hash == hash && item.key == key)
+        for (uint32_t distance = 1; _distances[slot] >= distance; distance++)
+        {
+            if (_items[slot].hash == hash && _items[slot].key == key)
             {
-                result = &item;
-                return Iteration::STOP;
+                return &_items[slot];
             }
-            else
+
+            slot = (slot + 1) & mask;
+        }
+
+        return nullptr;
+    }
+
+    // The key must not be in the map already, returns where it ended up.
+    Item &insert(Item &&item)
+    {
+        size_t mask = _capacity - 1;
+        size_t slot = ideal_slot(item.hash);
+        uint32_t distance = 1;
+
+        Item *inserted = nullptr;
+
+        while (_distances[slot] != 0)
+        {
+            if (_distances[slot] < distance)
             {
-                return Iteration::CONTINUE;
+                swap(_items[slot], item);
+                swap(_distances[slot], distance);
+
+                if (!inserted)
+                {
+                    inserted = &_items[slot];
+                }
             }
-        });
 
-        return result;
+            slot = (slot + 1) & mask;
+            distance++;
+        }
+
+        new (&_items[slot]) Item(move(item));
+        _distances[slot] = distance;
+        _count++;
+
+        return inserted ? *inserted : _items[slot];
     }
 
-public:
-    size_t count()
+    void remove_slot(size_t slot)
     {
-        size_t result = 0;
+        size_t mask = _capacity - 1;
 
-        for (size_t i = 0; i < BUCKET_COUNT; i++)
+        _items[slot].~Item();
+
+        // Shift the items after it back, so there are no holes in the probe sequences.
+        size_t next = (slot + 1) & mask;
+
+        while (_distances[next] > 1)
         {
-            result += _buckets[i].count();
+            new (&_items[slot]) Item(move(_items[next]));
+            _items[next].~Item();
+            _distances[slot] = _distances[next] - 1;
+
+            slot = next;
+            next = (next + 1) & mask;
         }
 
-        return result;
+        _distances[slot] = 0;
+        _count--;
     }
 
-    HashMap()
+    void rehash(size_t capacity)
+    {
+        Item *items = _items;
+        uint32_t *distances = _distances;
+        size_t old_capacity = _capacity;
+
+        _items = reinterpret_cast<Item *>(calloc(capacity, sizeof(Item)));
+        _distances = reinterpret_cast<uint32_t *>(calloc(capacity, sizeof(uint32_t)));
+        _capacity = capacity;
+        _count = 0;
+
+        _shift = 32;
+
+        while ((1u << (32 - _shift)) < capacity)
+        {
+            _shift--;
+        }
+
+        for (size_t i = 0; i < old_capacity; i++)
+        {
+            if (distances[i])
+            {
+                insert(move(items[i]));
+                items[i].~Item();
+            }
+        }
+
+        free(items);
+        free(distances);
+    }
+
+    void ensure_room_for_one_more()
     {
-        for (size_t i = 0; i < BUCKET_COUNT; i++)
+        // Keep the load factor under 3/4.
+        if ((_count + 1) * 4 > _capacity * 3)
         {
-            _buckets.push_back({});
+            rehash(MAX(_capacity * 2, MIN_CAPACITY));
         }
     }
 
+    void copy_from(const HashMap &other)
+    {
+        if (other._count == 0)
+        {
+            return;
+        }
+
+        rehash(other._capacity);
+
+        for (size_t i = 0; i < other._capacity; i++)
+        {
+            if (other._distances[i])
+            {
+                insert({other._items[i].hash, other._items[i].key, other._items[i].value});
+            }
+        }
+    }
+
+public:
+    size_t count() const
+    {
+        return _count;
+    }
+
+    HashMap()
+    {
+    }
+
     HashMap(const HashMap &other)
-        : _buckets(other._buckets)
     {
+        copy_from(other);
     }
 
     HashMap(HashMap &&other)
-        : _buckets(move(other._buckets))
     {
+        swap(_items, other._items);
+        swap(_distances, other._distances);
+        swap(_capacity, other._capacity);
+        swap(_count, other._count);
+        swap(_shift, other._shift);
+    }
+
+    ~HashMap()
+    {
+        clear();
+
+        free(_items);
+        free(_distances);
     }
 
     void clear()
     {
-        _buckets.clear();
+        for (size_t i = 0; i < _capacity; i++)
+        {
+            if (_distances[i])
+            {
+                _items[i].~Item();
+                _distances[i] = 0;
+            }
+        }
+
+        _count = 0;
     }
 
-    void remove_key(TKey &key)
+    template <typename TLookup>
+    void remove_key(const TLookup &key)
     {
-        uint32_t h = hash<TKey>(key);
+        Item *item = item_by_key(key);
 
-        bucket(h).remove_all_match([&](auto &item) {
-            return item.hash == h && item.key == key;
-        });
+        if (item)
+        {
+            remove_slot(item - _items);
+        }
     }
 
     void remove_value(TValue &value)
     {
-        _buckets.foreach ([&](auto &bucket) {
-            bucket.remove_all_match([&](auto &item) {
-                return item.value == value;
-            });
-
-            return Iteration::CONTINUE;
-        });
+        for (size_t i = 0; i < _capacity; i++)
+        {
+            // Removing shifts the next items back into this slot.
+            while (_distances[i] && _items[i].value == value)
+            {
+                remove_slot(i);
+            }
+        }
     }
 
-    bool has_key(const TKey &key)
+    template <typename TLookup>
+    bool has_key(const TLookup &key) const
     {
         return item_by_key(key) != nullptr;
     }
@@ -129,25 +290,49 @@ public:
         return result;
     }
 
+    // The value for the key, or nullptr if there is none.
+    template <typename TLookup>
+    TValue *lookup(const TLookup &key) const
+    {
+        Item *item = item_by_key(key);
+
+        return item ? &item->value : nullptr;
+    }
+
     template <typename TCallback>
     Iteration foreach (TCallback callback) const
     {
-        return _buckets.foreach ([&](auto &bucket) {
-            return bucket.foreach ([&](auto &item) {
-                return callback(item.key, item.value);
-            });
-        });
+        for (size_t i = 0; i < _capacity; i++)
+        {
+            if (_distances[i] &&
+                callback(_items[i].key, _items[i].value) == Iteration::STOP)
+            {
+                return Iteration::STOP;
+            }
+        }
+
+        return Iteration::CONTINUE;
     }
 
     HashMap &operator=(const HashMap &other)
     {
-        _buckets = other._buckets;
+        if (this != &other)
+        {
+            clear();
+            copy_from(other);
+        }
+
         return *this;
     }
 
     HashMap &operator=(HashMap &&other)
     {
-        swap(_buckets, other._buckets);
+        swap(_items, other._items);
+        swap(_distances, other._distances);
+        swap(_capacity, other._capacity);
+        swap(_count, other._count);
+        swap(_shift, other._shift);
+
         return *this;
     }
 
@@ -162,8 +347,8 @@ public:
         }
         else
         {
-            auto &b = bucket(h);
-            return b.push_back({h, key, {}}).value;
+            ensure_room_for_one_more();
+            return insert({h, key, {}}).value;
         }
     }
 };
@@ -4,31 +4,30 @@
 #include <libsystem/Logger.h>
 #include <libsystem/core/CString.h>
 #include <libsystem/io/Stream.h>
+#include <libsystem/math/MinMax.h>
 #include <libsystem/unicode/Codepoint.h>
 #include <libsystem/utils/NumberParser.h>
 #include <libutils/RingBuffer.h>
 
-class Scanner
+// The helpers shared by all the scanners, they go through the ended(),
+// foreward() and peek() of TScanner, so they are only virtual for Scanner.
+template <typename TScanner>
+class ScannerBase
 {
-public:
-    virtual ~Scanner(){};
-
-    virtual bool ended() = 0;
-
-    virtual void foreward() = 0;
-
-    virtual char peek(size_t peek) = 0;
+private:
+    TScanner &self() { return static_cast<TScanner &>(*this); }
 
+public:
     bool do_continue()
     {
-        return !ended();
+        return !self().ended();
     }
 
     void foreward(size_t n)
     {
         for (size_t i = 0; i < n; i++)
         {
-            foreward();
+            self().foreward();
         }
     }
 
@@ -36,31 +35,31 @@ public:
     {
         if ((current() & 0xf8) == 0xf0)
         {
-            foreward(4);
+            self().foreward(4);
         }
         else if ((current() & 0xf0) == 0xe0)
         {
-            foreward(3);
+            self().foreward(3);
         }
         else if ((current() & 0xe0) == 0xc0)
         {
-            foreward(2);
+            self().foreward(2);
         }
         else
         {
-            foreward(1);
+            self().foreward(1);
         }
     }
 
     char current()
     {
-        return peek(0);
+        return self().peek(0);
     }
 
     Codepoint current_codepoint()
     {
         size_t size = 0;
-        Codepoint codepoint = peek(0);
+        Codepoint codepoint = self().peek(0);
 
         if ((current() & 0xf8) == 0xf0)
         {
@@ -80,7 +79,7 @@ public:
 
         for (size_t i = 1; i < size; i++)
         {
-            codepoint |= (0x3f & peek(i)) << (6 * (size - i - 1));
+            codepoint |= (0x3f & self().peek(i)) << (6 * (size - i - 1));
         }
 
         return codepoint;
@@ -93,9 +92,11 @@ public:
 
     bool current_is(const char *what, size_t size)
     {
+        char chr = current();
+
         for (size_t i = 0; i < size; i++)
         {
-            if (current() == what[i])
+            if (chr == what[i])
             {
                 return true;
             }
@@ -108,7 +109,7 @@ public:
     {
         for (size_t i = 0; word[i]; i++)
         {
-            if (peek(i) != word[i])
+            if (self().peek(i) != word[i])
             {
                 return false;
             }
@@ -122,7 +123,7 @@ public:
         while (current_is(what) &&
                do_continue())
         {
-            foreward();
+            self().foreward();
         }
     }
 
@@ -130,7 +131,7 @@ public:
     {
         if (current() == chr)
         {
-            foreward();
+            self().foreward();
 
             return true;
         }
@@ -142,7 +143,7 @@ public:
     {
         if (current_is(chr))
         {
-            foreward();
+            self().foreward();
 
             return true;
         }
@@ -154,10 +155,7 @@ public:
     {
         if (current_is_word(word))
         {
-            for (size_t i = 0; i < strlen(word); i++)
-            {
-                foreward();
-            }
+            self().foreward(strlen(word));
 
             return true;
         }
@@ -166,6 +164,20 @@ public:
     }
 };
 
+class Scanner : public ScannerBase<Scanner>
+{
+public:
+    virtual ~Scanner(){};
+
+    virtual bool ended() = 0;
+
+    virtual void foreward() = 0;
+
+    using ScannerBase::foreward;
+
+    virtual char peek(size_t peek) = 0;
+};
+
 class StreamScanner : public Scanner
 {
 private:
@@ -266,3 +278,71 @@ public:
         return _string[offset];
     }
 };
+
+// Scans a buffer already in memory without going through virtual calls,
+// runs of bytes can be skipped and copied in one go using position().
+class SpanScanner : public ScannerBase<SpanScanner>
+{
+private:
+    const char *_current = nullptr;
+    const char *_end = nullptr;
+
+public:
+    const char *position() { return _current; }
+
+    size_t remaining() { return _end - _current; }
+
+    SpanScanner(const char *string, size_t size)
+        : _current(string), _end(string + size)
+    {
+    }
+
+    bool ended()
+    {
+        return _current >= _end;
+    }
+
+    void foreward()
+    {
+        if (_current < _end)
+        {
+            _current++;
+        }
+    }
+
+    void foreward(size_t n)
+    {
+        _current += MIN(n, remaining());
+    }
+
+    char peek(size_t peek)
+    {
+        if (peek >= remaining())
+        {
+            return '\0';
+        }
+
+        return _current[peek];
+    }
+
+    // Skips the bytes for which the predicate is true, and returns how many there were.
+    template <typename TPredicate>
+    size_t eat_while(TPredicate predicate)
+    {
+        const char *start = _current;
+
+        while (_current < _end && predicate(*_current))
+        {
+            _current++;
+        }
+
+        return _current - start;
+    }
+
+    void eat_whitespace()
+    {
+        eat_while([](char chr) {
+            return chr == ' ' || chr == '\n' || chr == '\r' || chr == '\t';
+        });
+    }
+};
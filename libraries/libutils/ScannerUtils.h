@@ -7,7 +7,8 @@
 #include <libutils/Scanner.h>
 #include <libutils/Strings.h>
 
-static inline const char *scan_json_escape_sequence(Scanner &scan)
+template <typename TScanner>
+static inline const char *scan_json_escape_sequence(TScanner &scan)
 {
     scan.skip('\\');
 
@@ -108,7 +109,8 @@ static inline const char *scan_json_escape_sequence(Scanner &scan)
     return buffer;
 }
 
-static inline unsigned int scan_uint(Scanner &scan, int base)
+template <typename TScanner>
+static inline unsigned int scan_uint(TScanner &scan, int base)
 {
     assert(base >= 2 && base <= 16);
 
@@ -123,7 +125,8 @@ static inline unsigned int scan_uint(Scanner &scan, int base)
     return v;
 }
 
-static inline int scan_int(Scanner &scan, int base)
+template <typename TScanner>
+static inline int scan_int(TScanner &scan, int base)
 {
     assert(base >= 2 && base <= 16);
 
@@ -150,8 +153,13 @@ static inline int scan_int(Scanner &scan, int base)
 
 #ifndef __KERNEL__
 
-static inline double scan_float(Scanner &scan)
+template <typename TScanner>
+static inline double scan_float(TScanner &scan)
 {
+    // The sign applies to the fractional part too.
+    double sign = scan.current_is("-") ? -1 : 1;
+    scan.skip("+-");
+
     int ipart = scan_int(scan, 10);
 
     double fpart = 0;
@@ -176,12 +184,13 @@ static inline double scan_float(Scanner &scan)
         exp = scan_int(scan, 10);
     }
 
-    return (ipart + fpart) * pow(10, exp);
+    return sign * (ipart + fpart) * pow(10, exp);
 }
 
 #endif
 
-static inline void scan_skip_utf8bom(Scanner &scan)
+template <typename TScanner>
+static inline void scan_skip_utf8bom(TScanner &scan)
 {
     scan.skip_word("\xEF\xBB\xBF");
 }
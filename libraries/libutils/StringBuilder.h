@@ -41,6 +41,28 @@ public:
             delete[] _buffer;
     }
 
+    // Makes room for how_many more chars and the null terminator.
+    void reserve(size_t how_many)
+    {
+        if (_size == 0)
+        {
+            _buffer = new char[16];
+            _size = 16;
+            _used = 0;
+        }
+
+        if (_used + how_many >= _size)
+        {
+            auto new_size = MAX(_size + _size / 4, _used + how_many + 1);
+            auto new_buffer = new char[new_size];
+            memcpy(new_buffer, _buffer, _used);
+            delete[] _buffer;
+
+            _size = new_size;
+            _buffer = new_buffer;
+        }
+    }
+
     String finalize()
     {
         char *result = _buffer;
@@ -60,12 +82,7 @@ public:
 
     StringBuilder &append(String string)
     {
-        for (size_t i = 0; i < string.length(); i++)
-        {
-            append(string[i]);
-        }
-
-        return *this;
+        return append(string.cstring(), string.length());
     }
 
     StringBuilder &append(const char *str)
@@ -76,10 +93,7 @@ public:
         }
         else
         {
-            for (size_t i = 0; str[i]; i++)
-            {
-                append(str[i]);
-            }
+            append(str, strlen(str));
         }
 
         return *this;
@@ -93,10 +107,11 @@ public:
         }
         else
         {
-            for (size_t i = 0; i < size; i++)
-            {
-                append(str[i]);
-            }
+            reserve(size);
+
+            memcpy(_buffer + _used, str, size);
+            _used += size;
+            _buffer[_used] = '\0';
         }
 
         return *this;
@@ -104,23 +119,7 @@ public:
 
     StringBuilder &append(char chr)
     {
-        if (_size == 0)
-        {
-            _buffer = new char[16];
-            _size = 16;
-            _used = 0;
-        }
-
-        if (_used + 1 == _size)
-        {
-            auto new_size = _size + _size / 4;
-            auto new_buffer = new char[new_size];
-            memcpy(new_buffer, _buffer, _size);
-            delete[] _buffer;
-
-            _size = new_size;
-            _buffer = new_buffer;
-        }
+        reserve(1);
 
         _buffer[_used] = chr;
         _buffer[_used + 1] = '\0';
@@ -224,6 +224,11 @@ void widget_apply_attribute_from_markup(Widget *widget, markup::Node &node)
     {
         widget->attributes(LAYOUT_FILL);
     }
+
+    if (node.has_attribute("layered"))
+    {
+        widget->layered(true);
+    }
 }
 
 Widget *widget_create_from_markup(Widget *parent, markup::Node &node)
@@ -362,6 +367,11 @@ WindowFlag window_flags_from_markup(markup::Node &node)
         flags |= WINDOW_TRANSPARENT;
     }
 
+    if (node.has_attribute("acrylic"))
+    {
+        flags |= WINDOW_TRANSPARENT | WINDOW_ACRYLIC;
+    }
+
     return flags;
 }
 
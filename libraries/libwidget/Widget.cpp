@@ -2,6 +2,7 @@
 #include <libgraphic/Painter.h>
 #include <libsystem/Assert.h>
 #include <libsystem/Logger.h>
+#include <libsystem/core/CString.h>
 #include <libsystem/io/Stream.h>
 #include <libsystem/math/MinMax.h>
 #include <libwidget/Application.h>
@@ -298,19 +299,33 @@ void Widget::do_layout()
 
 void Widget::relayout()
 {
-    do_layout();
-
-    if (_childs->count() == 0)
-        return;
+    if (_layout_dirty)
+    {
+        do_layout();
+        _layout_dirty = false;
+    }
 
+    // Any dirty widget has dirty ancestors, so clean subtrees can be skipped.
     list_foreach(Widget, child, _childs)
     {
-        child->relayout();
+        if (child->_layout_dirty)
+        {
+            child->relayout();
+        }
     }
 }
 
 void Widget::should_relayout()
 {
+    // Our size might change the size of our ancestors and where their
+    // childs are placed, so they all need to be measured and laid out again.
+    for (Widget *widget = this; widget; widget = widget->_parent)
+    {
+        widget->_size_dirty = true;
+        widget->_layout_dirty = true;
+        widget->_layer_damage = widget->bound();
+    }
+
     if (_window)
     {
         _window->should_relayout();
@@ -488,6 +503,18 @@ void Widget::repaint(Painter &painter, Rectangle rectangle)
     if (bound().width() == 0 || bound().height() == 0)
         return;
 
+    if (_layered)
+    {
+        repaint_layer(painter, rectangle);
+    }
+    else
+    {
+        repaint_content(painter, rectangle);
+    }
+}
+
+void Widget::repaint_content(Painter &painter, Rectangle rectangle)
+{
     painter.push();
     painter.clip(bound());
 
@@ -516,16 +543,89 @@ void Widget::repaint(Painter &painter, Rectangle rectangle)
     painter.pop();
 }
 
-void Widget::should_repaint()
+void Widget::repaint_layer(Painter &painter, Rectangle rectangle)
 {
-    if (_window)
+    if (!_layer || _layer->size() != bound().size())
+    {
+        auto layer_or_error = Bitmap::create_shared(bound().width(), bound().height());
+
+        if (!layer_or_error.success())
+        {
+            repaint_content(painter, rectangle);
+            return;
+        }
+
+        _layer = layer_or_error.take_value();
+        _layer_damage = bound();
+    }
+
+    _layer_damage = _layer_damage.clipped_with(bound());
+
+    if (!_layer_damage.is_empty())
     {
-        _window->should_repaint(bound());
+        Painter layer_painter{_layer};
+        layer_painter.transform(-bound().position());
+        layer_painter.clip(_layer_damage);
+
+        layer_painter.clear_rectangle(_layer_damage, Colors::BLACKTRANSPARENT);
+        repaint_content(layer_painter, _layer_damage);
+
+        _layer_damage = Rectangle::empty();
+        _layer_paints++;
+    }
+    else
+    {
+        _layer_reuses++;
+    }
+
+    Rectangle destination = rectangle.clipped_with(bound());
+    painter.blit_bitmap(*_layer, destination.offset(-bound().position()), destination);
+
+    if (application_is_debbuging_layout())
+    {
+        char counters[32];
+        snprintf(counters, 32, "%d/%d", _layer_paints, _layer_reuses);
+
+        painter.push();
+        painter.clip(bound());
+        painter.draw_rectangle(bound(), Colors::LIME);
+        painter.draw_string(*font(), counters, bound().position() + Vec2i(2, 12), Colors::LIME);
+        painter.pop();
+    }
+}
+
+void Widget::damage_layers(Rectangle rectangle)
+{
+    for (Widget *widget = this; widget; widget = widget->_parent)
+    {
+        if (widget->_layered)
+        {
+            widget->_layer_damage = widget->_layer_damage.is_empty()
+                                        ? rectangle
+                                        : widget->_layer_damage.merged_with(rectangle);
+        }
     }
 }
 
+void Widget::invalidate_layers()
+{
+    _layer_damage = bound();
+
+    list_foreach(Widget, child, _childs)
+    {
+        child->invalidate_layers();
+    }
+}
+
+void Widget::should_repaint()
+{
+    should_repaint(bound());
+}
+
 void Widget::should_repaint(Rectangle rectangle)
 {
+    damage_layers(rectangle);
+
     if (_window)
     {
         _window->should_repaint(rectangle);
@@ -558,6 +658,11 @@ void Widget::dispatch_event(Event *event)
 
 Vec2i Widget::compute_size()
 {
+    if (!_size_dirty)
+    {
+        return _computed_size;
+    }
+
     Vec2i size = this->size();
 
     int width = size.x();
@@ -586,5 +691,8 @@ Vec2i Widget::compute_size()
         height = MAX(height, _min_height);
     }
 
-    return Vec2i(width, height);
+    _computed_size = Vec2i(width, height);
+    _size_dirty = false;
+
+    return _computed_size;
 }
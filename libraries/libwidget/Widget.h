@@ -75,6 +75,20 @@ private:
     RefPtr<Font> _font;
     LayoutAttributes _layout_attributes = {};
 
+    // Measured sizes are kept until the widget or one of its descendants
+    // changes, and only the subtrees whose bound changed are laid out again.
+    Vec2i _computed_size = {};
+    bool _size_dirty = true;
+    bool _layout_dirty = true;
+
+    // Opt-in offscreen copy of the widget and its childs, only the damaged
+    // part is painted again and the rest is blitted from the layer.
+    bool _layered = false;
+    RefPtr<Bitmap> _layer;
+    Rectangle _layer_damage = Rectangle::empty();
+    int _layer_paints = 0;
+    int _layer_reuses = 0;
+
     EventHandler _handlers[EventType::__COUNT] = {};
 
     struct Widget *_parent = {};
@@ -98,6 +112,7 @@ public:
     void font(RefPtr<Font> font)
     {
         _font = font;
+        should_relayout();
     }
 
     Color color(ThemeColorRole role);
@@ -106,7 +121,23 @@ public:
     Rectangle content_bound() const { return bound().shrinked(_insets); }
 
     Rectangle bound() const { return _bound; }
-    void bound(Rectangle value) { _bound = value; }
+    void bound(Rectangle value)
+    {
+        if (_bound != value)
+        {
+            // Some widgets measure themselves from their bound, so the
+            // cached size is stale once it is resized. Only this widget is
+            // measured again, its ancestors are the ones resizing it.
+            if (_bound.width() != value.width() || _bound.height() != value.height())
+            {
+                _size_dirty = true;
+            }
+
+            _bound = value;
+            _layout_dirty = true;
+            _layer_damage = value;
+        }
+    }
 
     Insets insets() const { return _insets; }
     void insets(Insets insets)
@@ -115,9 +146,27 @@ public:
         should_relayout();
     }
 
-    void layout(Layout layout) { _layout = layout; }
+    void layout(Layout layout)
+    {
+        _layout = layout;
+        should_relayout();
+    }
+
+    void attributes(LayoutAttributes attributes)
+    {
+        _layout_attributes = attributes;
+        should_relayout();
+    }
+
+    bool layered() { return _layered; }
+
+    void layered(bool layered)
+    {
+        _layered = layered;
+        _layer = nullptr;
+        should_repaint();
+    }
 
-    void attributes(LayoutAttributes attributes) { _layout_attributes = attributes; }
     LayoutAttributes attributes() { return _layout_attributes; }
 
     void window(Window *window)
@@ -132,13 +181,29 @@ public:
         return _window;
     }
 
-    void max_height(int value) { _max_height = value; }
+    void max_height(int value)
+    {
+        _max_height = value;
+        should_relayout();
+    }
 
-    void max_width(int value) { _max_width = value; }
+    void max_width(int value)
+    {
+        _max_width = value;
+        should_relayout();
+    }
 
-    void min_height(int value) { _min_height = value; }
+    void min_height(int value)
+    {
+        _min_height = value;
+        should_relayout();
+    }
 
-    void min_width(int value) { _min_width = value; }
+    void min_width(int value)
+    {
+        _min_width = value;
+        should_relayout();
+    }
 
     /* --- subclass API ----------------------------------------------------- */
 
@@ -188,6 +253,14 @@ public:
 
     void repaint(Painter &painter, Rectangle rectangle);
 
+    void repaint_content(Painter &painter, Rectangle rectangle);
+
+    void repaint_layer(Painter &painter, Rectangle rectangle);
+
+    void damage_layers(Rectangle rectangle);
+
+    void invalidate_layers();
+
     void should_repaint();
 
     void should_repaint(Rectangle rectangle);
@@ -4,6 +4,7 @@
 #include <libsystem/eventloop/EventLoop.h>
 #include <libsystem/io/Stream.h>
 #include <libsystem/system/Memory.h>
+#include <libsystem/system/System.h>
 #include <libwidget/Application.h>
 #include <libwidget/Event.h>
 #include <libwidget/Screen.h>
@@ -163,6 +164,9 @@ void Window::repaint_dirty()
     Rectangle repaited_regions = Rectangle::empty();
     Painter &painter = *backbuffer_painter;
 
+    uint start = system_get_ticks();
+    size_t dirty_rects_count = _dirty_rects.count();
+
     _dirty_rects.foreach ([&](Rectangle &rect) {
         repaint(painter, rect);
 
@@ -180,6 +184,11 @@ void Window::repaint_dirty()
 
     _dirty_rects.clear();
 
+    if (application_is_debbuging_layout())
+    {
+        logger_info("Repainted %d regions of %s in %dms", dirty_rects_count, _title.cstring(), system_get_ticks() - start);
+    }
+
     frontbuffer->copy_from(*backbuffer, repaited_regions);
 
     swap(frontbuffer, backbuffer);
@@ -397,6 +406,9 @@ void Window::dispatch_event(Event *event)
     {
         _focused = true;
 
+        // Colors depend on the focus, so the layers are stale.
+        header()->invalidate_layers();
+        root()->invalidate_layers();
         should_repaint(bound());
     }
     break;
@@ -404,6 +416,9 @@ void Window::dispatch_event(Event *event)
     case Event::LOST_FOCUS:
     {
         _focused = false;
+
+        header()->invalidate_layers();
+        root()->invalidate_layers();
         should_repaint(bound());
 
         Event mouse_leave = *event;
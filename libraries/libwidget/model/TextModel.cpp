@@ -1,60 +1,266 @@
-#include <libutils/Scanner.h>
+#include <libsystem/core/CString.h>
+#include <libsystem/io/File.h>
 
 #include <libwidget/model/TextModel.h>
 
 RefPtr<TextModel> TextModel::empty()
 {
-    auto model = make<TextModel>();
-    model->append_line(own<TextModelLine>());
-    return model;
+    return make<TextModel>();
 }
 
 RefPtr<TextModel> TextModel::from_file(const char *path)
 {
-    auto model = make<TextModel>();
+    char *buffer = nullptr;
+    size_t size = 0;
+
+    if (file_read_all(path, (void **)&buffer, &size) != SUCCESS)
+    {
+        return empty();
+    }
 
-    Stream *stream = stream_open(path, OPEN_READ | OPEN_BUFFERED);
+    auto model = make<TextModel>(Vector(ADOPT, buffer, size));
+
+    model->span_add(TextModelSpan(0, 0, 10, THEME_ANSI_RED, THEME_ANSI_BLUE));
+
+    return model;
+}
 
-    StreamScanner scan{stream};
+TextModel::TextModel(Vector<char> content)
+    : _original(move(content))
+{
+    size_t start = 0;
 
     // Skip the utf8 bom header if present.
-    scan.skip_word("\xEF\xBB\xBF");
+    if (_original.count() >= 3 && memcmp(_original.raw_storage(), "\xEF\xBB\xBF", 3) == 0)
+    {
+        start = 3;
+    }
+
+    if (_original.count() > start)
+    {
+        _pieces.push_back({TextModelBuffer::ORIGINAL, start, _original.count() - start});
+    }
+
+    _size = _original.count() - start;
+    _lines.push_back(0);
+
+    const char *data = _original.raw_storage() + start;
+
+    for (size_t i = 0; i < _size; i++)
+    {
+        if (data[i] == '\n')
+        {
+            _lines.push_back(i + 1);
+        }
+    }
+}
+
+size_t TextModel::split(size_t offset)
+{
+    size_t piece_offset = 0;
+
+    for (size_t i = 0; i < _pieces.count(); i++)
+    {
+        TextModelPiece &piece = _pieces[i];
+
+        if (piece_offset == offset)
+        {
+            return i;
+        }
+
+        if (offset < piece_offset + piece.length)
+        {
+            size_t left_length = offset - piece_offset;
+            TextModelPiece right{piece.buffer, piece.start + left_length, piece.length - left_length};
 
-    while (scan.do_continue())
+            piece.length = left_length;
+            _pieces.insert(i + 1, right);
+
+            return i + 1;
+        }
+
+        piece_offset += piece.length;
+    }
+
+    return _pieces.count();
+}
+
+void TextModel::read(size_t offset, size_t length, char *buffer)
+{
+    size_t piece_offset = 0;
+
+    for (size_t i = 0; i < _pieces.count() && length > 0; i++)
     {
-        auto line = own<TextModelLine>();
+        TextModelPiece &piece = _pieces[i];
 
-        while (scan.do_continue() &&
-               scan.current_codepoint() != '\n')
+        if (offset < piece_offset + piece.length)
         {
-            line->append(scan.current_codepoint());
-            scan.foreward_codepoint();
+            size_t start = offset - piece_offset;
+            size_t count = MIN(length, piece.length - start);
+
+            memcpy(buffer, piece_data(piece) + start, count);
+
+            buffer += count;
+            offset += count;
+            length -= count;
         }
-        scan.skip('\n'); // skip the \n
 
-        model->append_line(line);
+        piece_offset += piece.length;
+    }
+}
+
+size_t TextModel::line_end(size_t line)
+{
+    if (line + 1 < _lines.count())
+    {
+        // Stop before the '\n'.
+        return _lines[line + 1] - 1;
     }
 
-    stream_close(stream);
+    return _size;
+}
+
+size_t TextModel::line_of(size_t offset)
+{
+    size_t low = 0;
+    size_t high = _lines.count() - 1;
 
-    if (model->line_count() == 0)
+    while (low < high)
     {
-        model->append_line(own<TextModelLine>());
+        size_t middle = (low + high + 1) / 2;
+
+        if (_lines[middle] <= offset)
+        {
+            low = middle;
+        }
+        else
+        {
+            high = middle - 1;
+        }
     }
 
-    model->span_add(TextModelSpan(0, 0, 10, THEME_ANSI_RED, THEME_ANSI_BLUE));
+    return low;
+}
+
+size_t TextModel::offset_of(size_t line, size_t column)
+{
+    size_t start = line_start(line);
+    size_t length = line_end(line) - start;
 
-    if (model->line_count() == 0)
+    // Padded with zeros, utf8_to_codepoint reads past truncated sequences.
+    Vector<char> bytes(length + 4);
+    read(start, length, bytes.raw_storage());
+
+    // Columns are counted exactly like line() does, so they mean the same
+    // thing even when the line isn't valid utf8.
+    const uint8_t *data = reinterpret_cast<const uint8_t *>(bytes.raw_storage());
+    size_t offset = 0;
+
+    while (offset < length && column > 0)
     {
-        model->append_line(own<TextModelLine>());
+        Codepoint codepoint = 0;
+        offset = MIN(offset + utf8_to_codepoint(data + offset, &codepoint), length);
+
+        column--;
     }
 
-    return model;
+    return start + offset;
+}
+
+void TextModel::insert(size_t offset, const char *buffer, size_t length)
+{
+    size_t index = split(offset);
+
+    // Typing keeps appending to the same piece instead of adding a new one each time.
+    if (index > 0 &&
+        _pieces[index - 1].buffer == TextModelBuffer::ADDED &&
+        _pieces[index - 1].start + _pieces[index - 1].length == _added.count())
+    {
+        _pieces[index - 1].length += length;
+    }
+    else
+    {
+        _pieces.insert(index, {TextModelBuffer::ADDED, _added.count(), length});
+    }
+
+    for (size_t i = 0; i < length; i++)
+    {
+        _added.push_back(buffer[i]);
+    }
+
+    size_t line = line_of(offset);
+
+    for (size_t i = line + 1; i < _lines.count(); i++)
+    {
+        _lines[i] += length;
+    }
+
+    for (size_t i = 0; i < length; i++)
+    {
+        if (buffer[i] == '\n')
+        {
+            line++;
+            _lines.insert(line, offset + i + 1);
+        }
+    }
+
+    _size += length;
+}
+
+void TextModel::remove(size_t offset, size_t length)
+{
+    size_t first = split(offset);
+    size_t last = split(offset + length);
+
+    for (size_t i = first; i < last; i++)
+    {
+        _pieces.remove_index(first);
+    }
+
+    size_t line = line_of(offset);
+
+    while (line + 1 < _lines.count() && _lines[line + 1] <= offset + length)
+    {
+        _lines.remove_index(line + 1);
+    }
+
+    for (size_t i = line + 1; i < _lines.count(); i++)
+    {
+        _lines[i] -= length;
+    }
+
+    _size -= length;
+}
+
+TextModelLine TextModel::line(size_t index)
+{
+    size_t start = line_start(index);
+    size_t length = line_end(index) - start;
+
+    // Padded with zeros, utf8_to_codepoint reads past truncated sequences.
+    Vector<char> bytes(length + 4);
+    read(start, length, bytes.raw_storage());
+
+    Vector<Codepoint> codepoints(MAX(length, 16));
+    const uint8_t *current = reinterpret_cast<const uint8_t *>(bytes.raw_storage());
+    const uint8_t *end = current + length;
+
+    while (current < end)
+    {
+        Codepoint codepoint = 0;
+        current += utf8_to_codepoint(current, &codepoint);
+        codepoints.push_back(codepoint);
+    }
+
+    return TextModelLine(move(codepoints));
 }
 
 void TextModel::append_at(TextCursor &cursor, Codepoint codepoint)
 {
-    line(cursor.line()).append_at(cursor.column(), codepoint);
+    uint8_t utf8[5] = {};
+    int length = codepoint_to_utf8(codepoint, utf8);
+
+    insert(offset_of(cursor.line(), cursor.column()), reinterpret_cast<char *>(utf8), length);
     cursor.move_right_within(*this);
 }
 
@@ -63,54 +269,44 @@ void TextModel::backspace_at(TextCursor &cursor)
     if (cursor.line() > 0 &&
         cursor.column() == 0)
     {
-        int line_length = line(cursor.line() - 1).length();
-        line(cursor.line() - 1).append(line(cursor.line()));
+        size_t line_length = line(cursor.line() - 1).length();
 
-        _lines.remove_index(cursor.line());
+        remove(line_start(cursor.line()) - 1, 1);
 
         cursor.move_up_within(*this);
         cursor.move_to_within(line(cursor.line()), line_length);
     }
-    else if (cursor.column() > 0 && line(cursor.line()).length() > 0)
+    else if (cursor.column() > 0)
     {
-        line(cursor.line()).backspace_at(cursor.column());
+        size_t start = offset_of(cursor.line(), cursor.column() - 1);
+        size_t end = offset_of(cursor.line(), cursor.column());
+
+        remove(start, end - start);
         cursor.move_left_within(*this);
     }
 }
 
 void TextModel::delete_at(TextCursor &cursor)
 {
-    if (cursor.line() < line_count() - 1 && cursor.column() == line(cursor.line()).length())
-    {
-        line(cursor.line()).append(line(cursor.line() + 1));
+    size_t start = offset_of(cursor.line(), cursor.column());
 
-        _lines.remove_index(cursor.line() + 1);
+    if (start == line_end(cursor.line()))
+    {
+        if (cursor.line() < line_count() - 1)
+        {
+            remove(start, 1);
+        }
     }
-    else if (cursor.column() < line(cursor.line()).length() && line(cursor.line()).length() > 0)
+    else
     {
-        line(cursor.line()).delete_at(cursor.column());
+        size_t end = offset_of(cursor.line(), cursor.column() + 1);
+        remove(start, end - start);
     }
 }
 
 void TextModel::newline_at(TextCursor &cursor)
 {
-    auto left_side_line = own<TextModelLine>();
-    auto right_side_line = own<TextModelLine>();
-
-    for (size_t i = 0; i < cursor.column(); i++)
-    {
-        left_side_line->append(line(cursor.line())[i]);
-    }
-
-    for (size_t i = cursor.column(); i < line(cursor.line()).length(); i++)
-    {
-        right_side_line->append(line(cursor.line())[i]);
-    }
-
-    _lines.remove_index(cursor.line());
-
-    _lines.insert(cursor.line(), left_side_line);
-    _lines.insert(cursor.line() + 1, right_side_line);
+    insert(offset_of(cursor.line(), cursor.column()), "\n", 1);
 
     cursor.move_down_within(*this);
     cursor.move_to_beginning_of_the_line();
@@ -120,16 +316,37 @@ void TextModel::move_line_up_at(TextCursor &cursor)
 {
     if (cursor.line() > 0)
     {
-        _lines.insert(cursor.line() - 1, _lines.take_at(cursor.line()));
+        TextCursor above;
+        above.move_to_within(*this, cursor.line() - 1);
+
+        TextCursor current = cursor;
+        move_line_down_at(above);
+
+        cursor = current;
         cursor.move_up_within(*this);
     }
 }
 
 void TextModel::move_line_down_at(TextCursor &cursor)
 {
-    if (cursor.line() < line_count())
+    if (cursor.line() + 1 < line_count())
     {
-        _lines.insert(cursor.line() + 1, _lines.take_at(cursor.line()));
+        // Swap the two lines by taking them out and putting them back the other way around.
+        size_t start = line_start(cursor.line());
+        size_t middle = line_end(cursor.line());
+        size_t end = line_end(cursor.line() + 1);
+
+        Vector<char> bytes(end - start);
+        read(start, end - start, bytes.raw_storage());
+
+        Vector<char> swapped(end - start);
+        memcpy(swapped.raw_storage(), bytes.raw_storage() + (middle - start) + 1, end - middle - 1);
+        swapped.raw_storage()[end - middle - 1] = '\n';
+        memcpy(swapped.raw_storage() + (end - middle), bytes.raw_storage(), middle - start);
+
+        remove(start, end - start);
+        insert(start, swapped.raw_storage(), end - start);
+
         cursor.move_down_within(*this);
     }
 }
@@ -9,6 +9,7 @@
 
 struct TextCursor;
 
+// Codepoints of a single line, decoded from the document when asked for.
 class TextModelLine
 {
 private:
@@ -19,46 +20,39 @@ public:
     {
     }
 
+    TextModelLine(Vector<Codepoint> codepoints)
+        : _codepoints(move(codepoints))
+    {
+    }
+
     ~TextModelLine()
     {
     }
 
-    Codepoint operator[](size_t index)
+    Codepoint operator[](size_t index) const
     {
         assert(index < length());
 
         return _codepoints[index];
     }
 
-    size_t length()
+    size_t length() const
     {
         return _codepoints.count();
     }
+};
 
-    void append(Codepoint codepoint)
-    {
-        _codepoints.push_back(codepoint);
-    }
-
-    void append(TextModelLine &line)
-    {
-        _codepoints.push_back_many(line._codepoints);
-    }
-
-    void append_at(size_t index, Codepoint codepoint)
-    {
-        _codepoints.insert(index, codepoint);
-    }
-
-    void backspace_at(size_t index)
-    {
-        _codepoints.remove_index(index - 1);
-    }
+enum class TextModelBuffer
+{
+    ORIGINAL,
+    ADDED,
+};
 
-    void delete_at(size_t index)
-    {
-        _codepoints.remove_index(index);
-    }
+struct TextModelPiece
+{
+    TextModelBuffer buffer;
+    size_t start;
+    size_t length;
 };
 
 class TextModelSpan
@@ -100,28 +94,68 @@ public:
     }
 };
 
+// The document is kept as utf8 in a piece table: the original content of
+// the file is never modified, inserted text goes at the end of an append-only
+// buffer, and the document is the sequence of pieces of both buffers.
+// The byte offset of every line is kept up to date as the document is edited.
 class TextModel : public RefCounted<TextModel>
 {
 private:
-    Vector<OwnPtr<TextModelLine>> _lines{1024};
+    Vector<char> _original{};
+    Vector<char> _added{};
+    Vector<TextModelPiece> _pieces{};
+
+    Vector<size_t> _lines{};
+    size_t _size = 0;
+
     Vector<TextModelSpan> _spans{1024};
 
+    const char *piece_data(TextModelPiece &piece)
+    {
+        if (piece.buffer == TextModelBuffer::ORIGINAL)
+        {
+            return _original.raw_storage() + piece.start;
+        }
+        else
+        {
+            return _added.raw_storage() + piece.start;
+        }
+    }
+
+    size_t split(size_t offset);
+
+    void read(size_t offset, size_t length, char *buffer);
+
+    size_t line_start(size_t line) { return _lines[line]; }
+
+    size_t line_end(size_t line);
+
+    size_t line_of(size_t offset);
+
+    size_t offset_of(size_t line, size_t column);
+
+    void insert(size_t offset, const char *buffer, size_t length);
+
+    void remove(size_t offset, size_t length);
+
 public:
     static RefPtr<TextModel> empty();
 
     static RefPtr<TextModel> from_file(const char *path);
 
-    TextModel() {}
+    TextModel() : TextModel(Vector<char>{}) {}
+
+    TextModel(Vector<char> content);
 
     ~TextModel() {}
 
     /* --- Editing ---------------------------------------------------------- */
 
-    TextModelLine &line(int index) { return *_lines[index]; }
+    TextModelLine line(size_t index);
 
     size_t line_count() const { return _lines.count(); }
 
-    void append_line(OwnPtr<TextModelLine> line) { _lines.push_back(line); }
+    size_t size() const { return _size; }
 
     void append_at(TextCursor &cursor, Codepoint codepoint);
 
@@ -186,7 +220,7 @@ public:
         }
     }
 
-    void move_to_within(TextModelLine &line, size_t column)
+    void move_to_within(const TextModelLine &line, size_t column)
     {
         _column = clamp(column, 0, line.length());
         _prefered_column = _column;
@@ -269,7 +303,7 @@ public:
         _prefered_column = _column;
     }
 
-    void move_home_within(TextModelLine &line)
+    void move_home_within(const TextModelLine &line)
     {
         __unused(line);
 
@@ -277,7 +311,7 @@ public:
         _prefered_column = _column;
     }
 
-    void move_end_within(TextModelLine &line)
+    void move_end_within(const TextModelLine &line)
     {
         _column = line.length();
         _prefered_column = _column;
@@ -11,6 +11,7 @@ void Image::change_bitmap(RefPtr<Bitmap> bitmap)
     if (_bitmap != bitmap)
     {
         _bitmap = bitmap;
+        should_relayout();
         should_repaint();
     }
 }
@@ -73,10 +73,46 @@ int Table::row_at(Vec2i position) const
     return row;
 }
 
+void Table::update_cache(int first_row, int row_count)
+{
+    if (first_row == _cache_first_row && row_count == _cache_row_count)
+    {
+        return;
+    }
+
+    int column_count = _model->columns();
+
+    Vector<Variant> cache(row_count * column_count);
+
+    for (int row = first_row; row < first_row + row_count; row++)
+    {
+        for (int column = 0; column < column_count; column++)
+        {
+            if (row >= _cache_first_row && row < _cache_first_row + _cache_row_count)
+            {
+                cache.push_back(_cache[(row - _cache_first_row) * column_count + column]);
+            }
+            else
+            {
+                cache.push_back(_model->data(row, column));
+            }
+        }
+    }
+
+    _cache = move(cache);
+    _cache_first_row = first_row;
+    _cache_row_count = row_count;
+}
+
+Variant &Table::cell(int row, int column)
+{
+    return _cache[(row - _cache_first_row) * _model->columns() + column];
+}
+
 void Table::paint_cell(Painter &painter, int row, int column)
 {
     Rectangle bound = cell_bound(row, column);
-    Variant data = _model->data(row, column);
+    Variant &data = cell(row, column);
 
     painter.push();
     painter.clip(bound);
@@ -131,8 +167,6 @@ void Table::paint(Painter &painter, Rectangle rectangle)
         return;
     }
 
-    __unused(rectangle);
-
     painter.push();
     painter.clip(bound());
 
@@ -145,8 +179,20 @@ void Table::paint(Painter &painter, Rectangle rectangle)
     }
     else
     {
-        for (int row = MAX(0, _scroll_offset / TABLE_ROW_HEIGHT - 1);
-             row < MIN(_model->rows(), ((_scroll_offset + list_bound().height()) / TABLE_ROW_HEIGHT) + 1);
+        // Rows are only fetched for the visible part of the model, and
+        // only the ones that were damaged are painted. The row right above
+        // the list is painted too since it shows through the header.
+        int first_visible_row = MAX(0, _scroll_offset / TABLE_ROW_HEIGHT - 1);
+        int last_visible_row = MIN(_model->rows(), (_scroll_offset + list_bound().height()) / TABLE_ROW_HEIGHT + 1);
+
+        update_cache(first_visible_row, last_visible_row - first_visible_row);
+
+        Rectangle damaged = rectangle.clipped_with(body_bound());
+        int first_damaged_row = (damaged.top() - list_bound().y() + _scroll_offset) / TABLE_ROW_HEIGHT;
+        int last_damaged_row = (damaged.bottom() - list_bound().y() + _scroll_offset) / TABLE_ROW_HEIGHT + 1;
+
+        for (int row = MAX(first_visible_row, first_damaged_row);
+             row < MIN(last_visible_row, last_damaged_row);
              row++)
         {
 
@@ -166,6 +212,13 @@ void Table::paint(Painter &painter, Rectangle rectangle)
             }
         }
     }
+
+    if (!rectangle.colide_with(header_bound()))
+    {
+        painter.pop();
+        return;
+    }
+
     painter.blur_rectangle(header_bound(), 8);
     painter.fill_rectangle(header_bound(), color(THEME_BACKGROUND).with_alpha(0.9));
 
@@ -189,6 +242,53 @@ void Table::paint(Painter &painter, Rectangle rectangle)
     painter.pop();
 }
 
+void Table::select(int index)
+{
+    if (index == _selected)
+    {
+        return;
+    }
+
+    if (index < 0 || index >= _model->rows())
+    {
+        return;
+    }
+
+    if (_selected >= 0)
+    {
+        should_repaint(row_bound(_selected).clipped_with(bound()));
+    }
+
+    _selected = index;
+
+    scroll_to(_selected);
+    should_repaint(row_bound(_selected).clipped_with(bound()));
+}
+
+void Table::scroll_to(int row)
+{
+    int row_top = row * TABLE_ROW_HEIGHT;
+    int row_bottom = row_top + TABLE_ROW_HEIGHT;
+
+    if (row_top < _scroll_offset)
+    {
+        _scroll_offset = row_top;
+    }
+    else if (row_bottom > _scroll_offset + list_bound().height())
+    {
+        _scroll_offset = row_bottom - list_bound().height();
+    }
+    else
+    {
+        return;
+    }
+
+    _scrollbar->update(TABLE_ROW_HEIGHT * _model->rows(), list_bound().height(), _scroll_offset);
+    _scroll_offset = _scrollbar->value();
+
+    should_repaint();
+}
+
 void Table::event(Event *event)
 {
     if (!_model)
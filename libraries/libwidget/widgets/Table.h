@@ -1,6 +1,7 @@
 #pragma once
 
 #include <libutils/String.h>
+#include <libutils/Vector.h>
 
 #include <libwidget/model/TableModel.h>
 #include <libwidget/widgets/ScrollBar.h>
@@ -19,6 +20,12 @@ private:
 
     String _empty_message{"No data to display"};
 
+    // Cells of the rows that were visible during the last paint, so
+    // repaints and small scrolls don't go through the model again.
+    int _cache_first_row = 0;
+    int _cache_row_count = 0;
+    Vector<Variant> _cache{};
+
     Rectangle body_bound() const;
     Rectangle scrollbar_bound() const;
     Rectangle header_bound() const;
@@ -27,13 +34,19 @@ private:
     Rectangle column_bound(int column) const;
     Rectangle cell_bound(int row, int column) const;
     int row_at(Vec2i position) const;
+    void update_cache(int first_row, int row_count);
+    Variant &cell(int row, int column);
     void paint_cell(Painter &painter, int row, int column);
 
 public:
     void model(RefPtr<TableModel> model)
     {
         _model = model;
+        _cache_row_count = 0;
+
         _model_observer = model->observe([this](auto &) {
+            _cache_row_count = 0;
+
             should_repaint();
             should_relayout();
         });
@@ -46,21 +59,9 @@ public:
 
     int selected() { return _selected; }
 
-    void select(int index)
-    {
-        if (index == _selected)
-        {
-            return;
-        }
+    void select(int index);
 
-        if (index < 0 || index >= _model->rows())
-        {
-            return;
-        }
-
-        _selected = index;
-        should_repaint();
-    }
+    void scroll_to(int row);
 
     void scroll_to_top()
     {
@@ -37,6 +37,9 @@ void TextField::paint(Painter &painter, Rectangle rectangle)
         painter.fill_rectangle(this->content_bound().take_left(32).take_right(1), color(THEME_BORDER));
     }
 
+    // Also true right after an edit reset the width, even if it's still 0.
+    bool document_width_changed = _document_width == 0;
+
     auto paint_cursor = [this](Painter &painter, Vec2i position) {
         if (!_readonly)
         {
@@ -81,9 +84,10 @@ void TextField::paint(Painter &painter, Rectangle rectangle)
         }
 
         // Line content
-        auto &line = _model->line(i);
+        auto line = _model->line(i);
 
-        Vec2i current_position = line_bound.cutoff_left_and_right((_linenumbers ? 32 : 0) + 4, 0).position() + Vec2i(0, LINE_HEIGHT / 2 + 4);
+        Vec2i text_origin = line_bound.cutoff_left_and_right((_linenumbers ? 32 : 0) + 4, 0).position() + Vec2i(0, LINE_HEIGHT / 2 + 4);
+        Vec2i current_position = text_origin;
 
         for (size_t j = 0; j < line.length(); j++)
         {
@@ -119,6 +123,22 @@ void TextField::paint(Painter &painter, Rectangle rectangle)
         }
 
         painter.pop();
+
+        // Lines are only measured once they are painted, so opening a large
+        // document doesn't have to go through all of it. The width is taken
+        // from the text origin, the gutter is not part of the document.
+        int line_width = current_position.x() - text_origin.x() + 4;
+
+        if (line_width > _document_width)
+        {
+            _document_width = line_width;
+            document_width_changed = true;
+        }
+    }
+
+    if (document_width_changed)
+    {
+        update_scrollbar();
     }
 }
 
@@ -131,11 +151,13 @@ void TextField::event(Event *event)
         if (event->keyboard.key == KEYBOARD_KEY_UP && event->keyboard.modifiers & KEY_MODIFIER_ALT)
         {
             _model->move_line_up_at(_cursor);
+            did_edit();
             scroll_to_cursor();
         }
         else if (event->keyboard.key == KEYBOARD_KEY_DOWN && event->keyboard.modifiers & KEY_MODIFIER_ALT)
         {
             _model->move_line_down_at(_cursor);
+            did_edit();
             scroll_to_cursor();
         }
         else if (event->keyboard.key == KEYBOARD_KEY_UP && event->keyboard.modifiers & KEY_MODIFIER_CTRL)
@@ -214,21 +236,25 @@ void TextField::event(Event *event)
             if (event->keyboard.key == KEYBOARD_KEY_BKSPC)
             {
                 _model->backspace_at(_cursor);
+                did_edit();
                 scroll_to_cursor();
             }
             else if (event->keyboard.key == KEYBOARD_KEY_DELETE)
             {
                 _model->delete_at(_cursor);
+                did_edit();
                 scroll_to_cursor();
             }
             else if (event->keyboard.key == KEYBOARD_KEY_ENTER)
             {
                 _model->newline_at(_cursor);
+                did_edit();
                 scroll_to_cursor();
             }
             else if (event->keyboard.codepoint != 0)
             {
                 _model->append_at(_cursor, event->keyboard.codepoint);
+                did_edit();
                 scroll_to_cursor();
             }
         }
@@ -247,6 +273,12 @@ void TextField::event(Event *event)
     }
 }
 
+void TextField::did_edit()
+{
+    // Lines may have gotten shorter, measure them again on the next paint.
+    _document_width = 0;
+}
+
 void TextField::update_scrollbar()
 {
     int document_height = document_bound().height();
@@ -263,7 +295,7 @@ void TextField::update_scrollbar()
 
     _hscrollbar->update(
         document_bound().width() + ScrollBar::SIZE,
-        view_bound().width() - 32,
+        view_bound().width(),
         _hscroll_offset);
 }
 
@@ -18,6 +18,7 @@ private:
 
     int _vscroll_offset = 0;
     int _hscroll_offset = 0;
+    int _document_width = 0;
 
     bool _linenumbers = false;
     bool _multiline = true;
@@ -28,6 +29,8 @@ private:
 
     void scroll_to_cursor();
 
+    void did_edit();
+
     Rectangle linenumbers_bound() const
     {
         if (_linenumbers)
@@ -57,7 +60,7 @@ private:
         return Rectangle{
             -_hscroll_offset,
             -_vscroll_offset,
-            1024,
+            _document_width,
             (int)_model->line_count() * LINE_HEIGHT,
         }
             .offset(bound().position());
@@ -0,0 +1,182 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <libutils/HashMap.h>
+#include <libutils/String.h>
+
+// The fixed 256 buckets map HashMap used to be, for comparison.
+template <typename TKey, typename TValue>
+class ChainedHashMap
+{
+private:
+    struct Item
+    {
+        uint32_t hash;
+        TKey key;
+        TValue value;
+    };
+
+    static constexpr int BUCKET_COUNT = 256;
+
+    Vector<Vector<Item>> _buckets{};
+
+    Item *item_by_key(const TKey &key, uint32_t hash)
+    {
+        auto &bucket = _buckets[hash % BUCKET_COUNT];
+
+        for (size_t i = 0; i < bucket.count(); i++)
+        {
+            if (bucket[i].hash == hash && bucket[i].key == key)
+            {
+                return &bucket[i];
+            }
+        }
+
+        return nullptr;
+    }
+
+public:
+    ChainedHashMap()
+    {
+        for (size_t i = 0; i < BUCKET_COUNT; i++)
+        {
+            _buckets.push_back({});
+        }
+    }
+
+    bool has_key(const TKey &key)
+    {
+        return item_by_key(key, hash<TKey>(key)) != nullptr;
+    }
+
+    void remove_key(const TKey &key)
+    {
+        uint32_t h = hash<TKey>(key);
+
+        _buckets[h % BUCKET_COUNT].remove_all_match([&](auto &item) {
+            return item.hash == h && item.key == key;
+        });
+    }
+
+    TValue &operator[](const TKey &key)
+    {
+        auto h = hash<TKey>(key);
+        auto *i = item_by_key(key, h);
+
+        if (i)
+        {
+            return i->value;
+        }
+
+        return _buckets[h % BUCKET_COUNT].push_back({h, key, {}}).value;
+    }
+};
+
+static double now()
+{
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec + time.tv_nsec / 1e9;
+}
+
+static size_t sink = 0;
+
+// Small maps are built over and over, so every size does about the same amount of work.
+template <typename TMap, typename TKey>
+static void run(const char *name, TKey *keys, size_t count)
+{
+    int rounds = 200000 / count + 1;
+
+    double insert = 0;
+    double lookup = 0;
+    double erase = 0;
+
+    for (int round = 0; round < rounds; round++)
+    {
+        double start = now();
+        TMap map{};
+
+        for (size_t i = 0; i < count; i++)
+        {
+            map[keys[i]] = i;
+        }
+
+        insert += now() - start;
+        start = now();
+
+        for (size_t i = 0; i < count; i++)
+        {
+            sink += map.has_key(keys[(i * 7919) % count]);
+        }
+
+        lookup += now() - start;
+        start = now();
+
+        for (size_t i = 0; i < count; i += 2)
+        {
+            map.remove_key(keys[i]);
+        }
+
+        erase += now() - start;
+    }
+
+    double operations = (double)count * rounds / 1e6;
+
+    printf("%-24s %8zu keys insert %8.2fMop/s lookup %8.2fMop/s erase %8.2fMop/s\n",
+           name, count, operations / insert, operations / lookup, operations / 2 / erase);
+}
+
+int main(int, char const *[])
+{
+    const size_t sizes[] = {16, 1000, 100000};
+
+    for (size_t size : sizes)
+    {
+        uint32_t *numbers = (uint32_t *)malloc(sizeof(uint32_t) * size);
+        String *strings = new String[size];
+        const char **cstrings = (const char **)malloc(sizeof(const char *) * size);
+
+        for (size_t i = 0; i < size; i++)
+        {
+            numbers[i] = i * 2654435761u;
+
+            char buffer[32];
+            snprintf(buffer, 32, "identifier-%zu", i);
+            strings[i] = buffer;
+            cstrings[i] = strings[i].cstring();
+        }
+
+        run<ChainedHashMap<uint32_t, size_t>>("chained uint32", numbers, size);
+        run<HashMap<uint32_t, size_t>>("open uint32", numbers, size);
+        run<ChainedHashMap<String, size_t>>("chained String", strings, size);
+        run<HashMap<String, size_t>>("open String", strings, size);
+
+        // Looking up by const char * without building a String.
+        HashMap<String, size_t> map{};
+
+        for (size_t i = 0; i < size; i++)
+        {
+            map[strings[i]] = i;
+        }
+
+        int rounds = 200000 / size + 1;
+        double start = now();
+
+        for (int round = 0; round < rounds; round++)
+        {
+            for (size_t i = 0; i < size; i++)
+            {
+                sink += map.has_key(cstrings[(i * 7919) % size]);
+            }
+        }
+
+        printf("%-24s %8zu keys lookup %8.2fMop/s\n", "open const char *", size, (double)size * rounds / (now() - start) / 1e6);
+
+        free(numbers);
+        free(cstrings);
+        delete[] strings;
+    }
+
+    return sink == 0;
+}
@@ -0,0 +1,223 @@
+#include <malloc.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <libmarkup/Markup.h>
+#include <libsystem/Logger.h>
+#include <libsystem/io/File.h>
+#include <libsystem/json/Json.h>
+#include <libutils/Strings.h>
+
+#undef printf
+
+#define BENCH_JSON_SIZE (4 * 1024 * 1024)
+#define BENCH_MARKUP_SIZE (4 * 1024 * 1024)
+#define BENCH_ROUNDS 4
+#define BENCH_SCAN_ROUNDS 64
+
+// The parsers are linked without the rest of libsystem.
+
+void logger_log(LogLevel, const char *, uint, const char *, ...) {}
+
+Result file_read_all(const char *, void **, size_t *) { return ERR_NO_SUCH_FILE_OR_DIRECTORY; }
+
+struct Document
+{
+    const char *name;
+    char *buffer;
+    size_t size;
+};
+
+static double now()
+{
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec + time.tv_nsec / 1e9;
+}
+
+// Application manifests and theme entries, indented like the ones on disk.
+static Document generate_json(int &count)
+{
+    char *buffer = (char *)malloc(BENCH_JSON_SIZE + 1024);
+    size_t size = sprintf(buffer, "[\n");
+
+    for (count = 0; size < BENCH_JSON_SIZE; count++)
+    {
+        size += sprintf(
+            buffer + size,
+            "%s    {\n"
+            "        \"name\": \"application-%d\",\n"
+            "        \"title\": \"Application \\\"%d\\\" \\u00e9dition\",\n"
+            "        \"icon\": \"/Applications/application-%d/icon.png\",\n"
+            "        \"categories\": [\"system\", \"utilities\", \"development\"],\n"
+            "        \"version\": %d.%d,\n"
+            "        \"enabled\": %s,\n"
+            "        \"parent\": null,\n"
+            "        \"window\": {\"width\": %d, \"height\": %d, \"color\": \"#1e1e1e\"}\n"
+            "    }",
+            count ? ",\n" : "", count, count, count, count % 17, count % 10, count % 2 ? "true" : "false", 640 + count % 100, 480 + count % 50);
+    }
+
+    size += sprintf(buffer + size, "\n]\n");
+
+    return {"json", buffer, size};
+}
+
+// Window layouts like the .markup files of the applications.
+static Document generate_markup(int &count)
+{
+    char *buffer = (char *)malloc(BENCH_MARKUP_SIZE + 1024);
+    size_t size = sprintf(buffer, "<Window title=\"Benchmark\" icon=\"application\" width=\"640\" height=\"480\">\n");
+
+    for (count = 0; size < BENCH_MARKUP_SIZE; count++)
+    {
+        size += sprintf(
+            buffer + size,
+            "    <Container id=\"container-%d\" layout=\"vflow(4)\" insets=\"8\" flags=\"fill\">\n"
+            "        <Label text=\"Label number %d, with some words in it\" position=\"left\"/>\n"
+            "        <Button text=\"Ok\" icon=\"check\" filled/>\n"
+            "        <TextField text=\"\\\"quoted\\\" content\" />\n"
+            "    </Container>\n",
+            count, count);
+    }
+
+    size += sprintf(buffer + size, "</Window>\n");
+
+    return {"markup", buffer, size};
+}
+
+static int strings_seen = 0;
+
+// Counts the strings of the document, to compare the scanners without building a tree.
+__attribute__((noinline)) static int tokenize(Scanner &scan)
+{
+    int strings = 0;
+
+    while (scan.do_continue())
+    {
+        scan.eat(Strings::WHITESPACE);
+
+        if (scan.skip('"'))
+        {
+            while (scan.do_continue() && scan.current() != '"')
+            {
+                scan.foreward();
+            }
+
+            scan.skip('"');
+            strings++;
+        }
+        else
+        {
+            scan.foreward();
+        }
+    }
+
+    return strings;
+}
+
+static int tokenize(SpanScanner &scan)
+{
+    int strings = 0;
+
+    while (scan.do_continue())
+    {
+        scan.eat_whitespace();
+
+        if (scan.skip('"'))
+        {
+            scan.eat_while([](char chr) { return chr != '"'; });
+            scan.skip('"');
+            strings++;
+        }
+        else
+        {
+            scan.foreward();
+        }
+    }
+
+    return strings;
+}
+
+static size_t allocated()
+{
+    return mallinfo2().uordblks;
+}
+
+template <typename TParse>
+static double run(Document &document, int rounds, TParse parse)
+{
+    double start = now();
+
+    for (int i = 0; i < rounds; i++)
+    {
+        parse(document);
+    }
+
+    return document.size * rounds / (now() - start) / (1024 * 1024);
+}
+
+int main(int, char const *[])
+{
+    int json_count = 0;
+    Document json_document = generate_json(json_count);
+
+    size_t before = allocated();
+    auto json_root = json::parse(json_document.buffer, json_document.size);
+    size_t json_memory = allocated() - before;
+
+    if (json_root.length() != (size_t)json_count ||
+        json_root.get(json_count - 1).get("window").get("height").as_integer() != 480 + (json_count - 1) % 50)
+    {
+        fprintf(stderr, "json: unexpected result\n");
+        return 1;
+    }
+
+    StringScanner string_scanner{json_document.buffer, json_document.size};
+    SpanScanner span_scanner{json_document.buffer, json_document.size};
+
+    if (tokenize(string_scanner) != tokenize(span_scanner))
+    {
+        fprintf(stderr, "scan: unexpected result\n");
+        return 1;
+    }
+
+    printf("%-16s %8.2fMiB/s\n", "scan", run(json_document, BENCH_SCAN_ROUNDS, [](Document &document) {
+               StringScanner scan{document.buffer, document.size};
+               strings_seen += tokenize(scan);
+           }));
+
+    printf("%-16s %8.2fMiB/s\n", "scan-span", run(json_document, BENCH_SCAN_ROUNDS, [](Document &document) {
+               SpanScanner scan{document.buffer, document.size};
+               strings_seen += tokenize(scan);
+           }));
+
+    printf("%-16s %8.2fMiB/s %8zuKiB for %zuKiB\n", json_document.name, run(json_document, BENCH_ROUNDS, [](Document &document) {
+               json::parse(document.buffer, document.size);
+           }),
+           json_memory / 1024, json_document.size / 1024);
+
+    int markup_count = 0;
+    Document markup_document = generate_markup(markup_count);
+
+    before = allocated();
+    auto markup_root = markup::parse(markup_document.buffer, markup_document.size);
+    size_t markup_memory = allocated() - before;
+
+    if (markup_root.count_child() != (size_t)markup_count)
+    {
+        fprintf(stderr, "markup: unexpected result\n");
+        return 1;
+    }
+
+    printf("%-16s %8.2fMiB/s %8zuKiB for %zuKiB\n", markup_document.name, run(markup_document, BENCH_ROUNDS, [](Document &document) {
+               markup::parse(document.buffer, document.size);
+           }),
+           markup_memory / 1024, markup_document.size / 1024);
+
+    free(json_document.buffer);
+    free(markup_document.buffer);
+
+    return 0;
+}
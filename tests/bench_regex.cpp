@@ -0,0 +1,147 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <libsystem/regex/Regex.h>
+
+#define BENCH_LINE_COUNT 200000
+
+// The matcher grep used before, for comparison.
+static int matchstar(int c, const char *re, const char *text);
+
+static int matchhere(const char *re, const char *text)
+{
+    if (re[0] == '\0')
+    {
+        return 1;
+    }
+
+    if (re[1] == '*')
+    {
+        return matchstar(re[0], re + 2, text);
+    }
+
+    if (re[0] == '$' && re[1] == '\0')
+    {
+        return *text == '\0';
+    }
+
+    if (*text != '\0' && (re[0] == '.' || re[0] == *text))
+    {
+        return matchhere(re + 1, text + 1);
+    }
+
+    return 0;
+}
+
+static int matchstar(int c, const char *re, const char *text)
+{
+    do
+    {
+        if (matchhere(re, text))
+        {
+            return 1;
+        }
+    } while (*text != '\0' && (*text++ == c || c == '.'));
+
+    return 0;
+}
+
+static int backtracking_match(const char *re, const char *text)
+{
+    if (re[0] == '^')
+    {
+        return matchhere(re + 1, text);
+    }
+
+    do
+    {
+        if (matchhere(re, text))
+        {
+            return 1;
+        }
+    } while (*text++ != '\0');
+
+    return 0;
+}
+
+static double now()
+{
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec + time.tv_nsec / 1e9;
+}
+
+struct Line
+{
+    const char *text;
+    size_t length;
+};
+
+static void bench(const char *pattern, Line *lines, int count)
+{
+    auto regex = Regex::compile(pattern).take_value();
+
+    double start = now();
+    int backtracking_matches = 0;
+
+    for (int i = 0; i < count; i++)
+    {
+        backtracking_matches += backtracking_match(pattern, lines[i].text);
+    }
+
+    double backtracking = now() - start;
+
+    start = now();
+    int regex_matches = 0;
+
+    for (int i = 0; i < count; i++)
+    {
+        regex_matches += regex->match(lines[i].text, lines[i].length);
+    }
+
+    double automata = now() - start;
+
+    if (backtracking_matches != regex_matches)
+    {
+        printf("%-24s results differ: %d vs %d\n", pattern, backtracking_matches, regex_matches);
+        exit(1);
+    }
+
+    printf("%-24s %8d matches backtracking %8.2fms regex %8.2fms (%d dfa states)\n",
+           pattern, regex_matches, backtracking * 1000, automata * 1000, regex->dfa_state_count());
+}
+
+int main(int, char const *[])
+{
+    const char *words[] = {"int", "value", "return", "if", "else", "struct", "void", "buffer", "size", "count"};
+
+    Line *lines = (Line *)malloc(sizeof(Line) * BENCH_LINE_COUNT);
+
+    for (int i = 0; i < BENCH_LINE_COUNT; i++)
+    {
+        char *text = (char *)malloc(128);
+        int length = 0;
+
+        for (int j = 0; j < 8; j++)
+        {
+            length += sprintf(text + length, "%s%s", j ? " " : "", words[(i * 7 + j * 13 + i / 3) % 10]);
+        }
+
+        length += sprintf(text + length, " %d;", i);
+
+        lines[i] = {text, (size_t)length};
+    }
+
+    bench("buffer", lines, BENCH_LINE_COUNT);
+    bench("^return", lines, BENCH_LINE_COUNT);
+    bench("int.*count", lines, BENCH_LINE_COUNT);
+    bench("s.*e.*r.*9;$", lines, BENCH_LINE_COUNT);
+    bench("x*y*z*q", lines, BENCH_LINE_COUNT);
+
+    // Exponential for the backtracking matcher, only a few lines.
+    Line pathological[] = {{"aaaaaaaaaaaaaaaaaaaaaaaa", 24}};
+    bench("a*a*a*a*a*a*a*a*b", pathological, 1);
+
+    return 0;
+}
@@ -0,0 +1,141 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <libterminal/Terminal.h>
+
+#define BENCH_STREAM_SIZE (8 * 1024 * 1024)
+#define BENCH_CHUNK_SIZE 4096
+
+struct Stream
+{
+    const char *name;
+    char *buffer;
+    size_t size;
+};
+
+static double now()
+{
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec + time.tv_nsec / 1e9;
+}
+
+// Plain text, like cat of a source file.
+static Stream generate_cat()
+{
+    char *buffer = (char *)malloc(BENCH_STREAM_SIZE + 256);
+    size_t size = 0;
+
+    for (int i = 0; size < BENCH_STREAM_SIZE; i++)
+    {
+        size += sprintf(buffer + size, "%*s    int result_%d = compute(value_%d, %d); // line %d\r\n", (i % 4) * 4, "", i, i, i % 97, i);
+    }
+
+    return {"cat", buffer, size};
+}
+
+// Short colored lines, like ls --color or a build log.
+static Stream generate_colors()
+{
+    char *buffer = (char *)malloc(BENCH_STREAM_SIZE + 256);
+    size_t size = 0;
+
+    for (int i = 0; size < BENCH_STREAM_SIZE; i++)
+    {
+        size += sprintf(buffer + size, "\e[%dm%-12s\e[0m \e[1m%6d\e[0m file%d.cpp\r\n", 31 + i % 7, "entry", i, i);
+    }
+
+    return {"colors", buffer, size};
+}
+
+// Full screen redraws with cursor positioning, like top.
+static Stream generate_redraw()
+{
+    char *buffer = (char *)malloc(BENCH_STREAM_SIZE + 256);
+    size_t size = 0;
+
+    for (int i = 0; size < BENCH_STREAM_SIZE; i++)
+    {
+        size += sprintf(buffer + size, "\e[%d;1H\e[K\e[7m%5d\e[0m %-20s %3d%% \xe2\x96\x88\xe2\x96\x88", i % 24 + 1, i, "process", i % 100);
+    }
+
+    return {"redraw", buffer, size};
+}
+
+// Recorded with something like `script -c <command> recording.txt`.
+static Stream load_recording(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+
+    if (!file)
+    {
+        fprintf(stderr, "Failed to open %s\n", path);
+        exit(1);
+    }
+
+    fseek(file, 0, SEEK_END);
+    size_t size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    char *buffer = (char *)malloc(size);
+    size = fread(buffer, 1, size, file);
+    fclose(file);
+
+    return {path, buffer, size};
+}
+
+static double run(Stream &stream, bool bytewise)
+{
+    terminal::Terminal terminal{80, 24};
+
+    double start = now();
+
+    for (size_t offset = 0; offset < stream.size; offset += BENCH_CHUNK_SIZE)
+    {
+        size_t size = stream.size - offset < BENCH_CHUNK_SIZE ? stream.size - offset : BENCH_CHUNK_SIZE;
+
+        if (bytewise)
+        {
+            for (size_t i = 0; i < size; i++)
+            {
+                terminal.write(stream.buffer[offset + i]);
+            }
+        }
+        else
+        {
+            terminal.write(stream.buffer + offset, size);
+        }
+    }
+
+    return stream.size / (now() - start) / (1024 * 1024);
+}
+
+int main(int argc, char const *argv[])
+{
+    Stream streams[16];
+    int count = 0;
+
+    if (argc > 1)
+    {
+        for (int i = 1; i < argc && count < 16; i++)
+        {
+            streams[count++] = load_recording(argv[i]);
+        }
+    }
+    else
+    {
+        streams[count++] = generate_cat();
+        streams[count++] = generate_colors();
+        streams[count++] = generate_redraw();
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        printf("%-12s %8.2fMiB/s bytewise %8.2fMiB/s\n", streams[i].name, run(streams[i], false), run(streams[i], true));
+        free(streams[i].buffer);
+    }
+
+    return 0;
+}
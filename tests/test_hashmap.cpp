@@ -0,0 +1,88 @@
+#include <stdio.h>
+
+#include <libsystem/Assert.h>
+#include <libutils/HashMap.h>
+#include <libutils/String.h>
+
+int main(int, char const *[])
+{
+    HashMap<String, int> map{};
+
+    assert(map.count() == 0);
+    assert(!map.has_key("missing"));
+    assert(map.lookup("missing") == nullptr);
+
+    map["one"] = 1;
+    map["two"] = 2;
+
+    assert(map.count() == 2);
+    assert(map.has_key("one"));
+    assert(map.has_key(String("two")));
+    assert(*map.lookup("two") == 2);
+
+    map["one"] = 11;
+
+    assert(map.count() == 2);
+    assert(map["one"] == 11);
+
+    // Grows well past the first few resizes.
+    HashMap<uint32_t, uint32_t> numbers{};
+
+    for (uint32_t i = 0; i < 10000; i++)
+    {
+        numbers[i * 7] = i;
+    }
+
+    assert(numbers.count() == 10000);
+
+    for (uint32_t i = 0; i < 10000; i++)
+    {
+        assert(numbers.has_key(i * 7));
+        assert(!numbers.has_key(i * 7 + 1));
+        assert(numbers[i * 7] == i);
+    }
+
+    for (uint32_t i = 0; i < 10000; i += 2)
+    {
+        numbers.remove_key(i * 7);
+    }
+
+    assert(numbers.count() == 5000);
+
+    for (uint32_t i = 0; i < 10000; i++)
+    {
+        assert(numbers.has_key(i * 7) == (i % 2 == 1));
+    }
+
+    uint32_t sum = 0;
+
+    numbers.foreach ([&](auto &, auto &value) {
+        sum += value;
+        return Iteration::CONTINUE;
+    });
+
+    assert(sum == 25000000);
+
+    HashMap<uint32_t, uint32_t> copy = numbers;
+    HashMap<uint32_t, uint32_t> moved = move(copy);
+
+    assert(moved.count() == 5000);
+    assert(moved[7] == 1);
+
+    uint32_t one = 1;
+    moved.remove_value(one);
+
+    assert(!moved.has_key(7));
+    assert(moved.count() == 4999);
+
+    moved.clear();
+
+    assert(moved.count() == 0);
+    assert(!moved.has_key(21));
+
+    moved[21] = 3;
+
+    assert(moved[21] == 3);
+
+    return 0;
+}
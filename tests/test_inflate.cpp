@@ -0,0 +1,100 @@
+#include <stdio.h>
+
+#include <libgraphic/png/Inflate.h>
+#include <libsystem/Assert.h>
+#include <libsystem/core/CString.h>
+#include <libsystem/math/MinMax.h>
+
+// Generated with python's zlib.compress at levels 0 and 9.
+static const uint8_t _stored[] = {
+    0x78, 0x01, 0x01, 0x1c, 0x00, 0xe3, 0xff, 0x68, 0x65, 0x6c, 0x6c, 0x6f, 0x2c, 0x20, 0x68, 0x65,
+    0x6c, 0x6c, 0x6f, 0x2c, 0x20, 0x68, 0x65, 0x6c, 0x6c, 0x6f, 0x20, 0x69, 0x6e, 0x66, 0x6c, 0x61,
+    0x74, 0x65, 0x21, 0x91, 0x5a, 0x09, 0xf9,
+};
+
+static const uint8_t _fixed[] = {
+    0x78, 0xda, 0xcb, 0x48, 0xcd, 0xc9, 0xc9, 0xd7, 0x51, 0xc8, 0x40, 0xa2, 0x14, 0x32, 0xf3, 0xd2,
+    0x72, 0x12, 0x4b, 0x52, 0x15, 0x01, 0x91, 0x5a, 0x09, 0xf9,
+};
+
+static const uint8_t _dynamic[] = {
+    0x78, 0xda, 0x95, 0xd4, 0xc9, 0x15, 0xc2, 0x40, 0x0c, 0x04, 0xd1, 0xbb, 0xa3, 0x50, 0x08, 0xa8,
+    0x9b, 0xcd, 0xe1, 0x00, 0x36, 0x3b, 0x0c, 0x98, 0x31, 0x5b, 0xf4, 0x90, 0x42, 0x9d, 0x55, 0xb7,
+    0xff, 0x5a, 0x75, 0xdf, 0xc7, 0x7d, 0x3c, 0x6c, 0x4e, 0xb1, 0x1e, 0xca, 0xeb, 0x1a, 0xdb, 0xf2,
+    0x8e, 0xe3, 0x78, 0xb9, 0x3d, 0xa2, 0x3c, 0xfb, 0x21, 0xea, 0xff, 0x7c, 0x5e, 0x7d, 0x3f, 0xd1,
+    0x95, 0x5d, 0x4c, 0x9a, 0x0a, 0xea, 0x44, 0xb5, 0x50, 0x6d, 0x54, 0x4f, 0x51, 0x3d, 0x43, 0xf5,
+    0x1c, 0xd5, 0x0b, 0x54, 0x2f, 0x51, 0xdd, 0x32, 0x1d, 0x88, 0xc9, 0x34, 0x93, 0x71, 0x26, 0xf3,
+    0x4c, 0x06, 0x9a, 0x4c, 0x34, 0x19, 0x69, 0x32, 0xd3, 0x64, 0xa8, 0xc9, 0x54, 0xc5, 0x54, 0x05,
+    0x37, 0xca, 0x54, 0xc5, 0x54, 0xc5, 0x54, 0xc5, 0x54, 0xc5, 0x54, 0xc5, 0x54, 0xc5, 0x54, 0xc5,
+    0x54, 0xcd, 0x54, 0xcd, 0x54, 0x0d, 0x5f, 0x2f, 0x53, 0x35, 0x53, 0x35, 0x53, 0x35, 0x53, 0x35,
+    0x53, 0x35, 0x53, 0x75, 0xdb, 0xfc, 0x00, 0xda, 0x82, 0x93, 0xa7,
+};
+
+// A dynamic block declaring 288 literal and 32 distance codes (HLIT and
+// HDIST at their maximum), with code lengths filling all 320 of them.
+static const uint8_t _oversized_tables[] = {
+    0x78, 0x9c, 0xfd, 0x1f, 0x80, 0xe4, 0xff, 0x7f, 0x08,
+};
+
+// Feeds the stream a few bytes at the time, to go through refills.
+static Result inflate(const uint8_t *data, size_t size, uint8_t *output, size_t output_size)
+{
+    size_t position = 0;
+
+    Inflate inflate{[&](uint8_t *buffer, size_t buffer_size) {
+        size_t read = MIN(MIN(buffer_size, size - position), (size_t)7);
+        memcpy(buffer, data + position, read);
+        position += read;
+        return read;
+    }};
+
+    return inflate.read(output, output_size);
+}
+
+static void dynamic_text(char *buffer, size_t size)
+{
+    size_t length = 0;
+
+    for (int i = 0; i < 40; i++)
+    {
+        length += snprintf(buffer + length, size - length, "the quick brown fox jumps over the lazy dog %d\n", i);
+    }
+}
+
+int main(int, char const *[])
+{
+    const char *text = "hello, hello, hello inflate!";
+    uint8_t output[2048] = {};
+
+    assert(inflate(_stored, sizeof(_stored), output, strlen(text)) == SUCCESS);
+    assert(memcmp(output, text, strlen(text)) == 0);
+
+    memset(output, 0, sizeof(output));
+    assert(inflate(_fixed, sizeof(_fixed), output, strlen(text)) == SUCCESS);
+    assert(memcmp(output, text, strlen(text)) == 0);
+
+    char expected[2048] = {};
+    dynamic_text(expected, sizeof(expected));
+
+    memset(output, 0, sizeof(output));
+    assert(inflate(_dynamic, sizeof(_dynamic), output, strlen(expected)) == SUCCESS);
+    assert(memcmp(output, expected, strlen(expected)) == 0);
+
+    // Asking for more than the stream holds fails instead of making up bytes.
+    assert(inflate(_stored, sizeof(_stored), output, strlen(text) + 1) != SUCCESS);
+
+    // Truncated streams.
+    assert(inflate(_stored, sizeof(_stored) / 2, output, strlen(text)) != SUCCESS);
+    assert(inflate(_fixed, sizeof(_fixed) / 2, output, strlen(text)) != SUCCESS);
+    assert(inflate(_dynamic, sizeof(_dynamic) / 2, output, strlen(expected)) != SUCCESS);
+    assert(inflate(_dynamic, 2, output, 1) != SUCCESS);
+    assert(inflate(_dynamic, 0, output, 1) != SUCCESS);
+
+    assert(inflate(_oversized_tables, sizeof(_oversized_tables), output, 1) != SUCCESS);
+
+    // Not a zlib stream.
+    const uint8_t garbage[] = {0x12, 0x34, 0x56, 0x78};
+    assert(inflate(garbage, sizeof(garbage), output, 1) != SUCCESS);
+
+    return 0;
+}
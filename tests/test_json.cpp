@@ -0,0 +1,92 @@
+#include <stdio.h>
+
+#include <libsystem/Assert.h>
+#include <libsystem/json/Reader.h>
+#include <libsystem/json/Writer.h>
+
+int main(int, char const *[])
+{
+    StringBuilder builder{};
+    json::Writer writer{builder};
+
+    writer.begin_array();
+
+    writer.begin_object();
+    writer.member("id", 1);
+    writer.member("name", "system");
+    writer.member("user", false);
+    writer.member("ram", 2147483647);
+    writer.end_object();
+
+    writer.begin_object();
+    writer.member("id", -42);
+    writer.member("name", "say \"hello\"\n");
+    writer.member("user", true);
+    writer.key("children");
+    writer.begin_array();
+    writer.value(nullptr);
+    writer.begin_object();
+    writer.end_object();
+    writer.end_array();
+    writer.end_object();
+
+    writer.end_array();
+
+    String json = builder.finalize();
+
+    assert(json == "[{\"id\":1,\"name\":\"system\",\"user\":false,\"ram\":2147483647},"
+                   "{\"id\":-42,\"name\":\"say \\\"hello\\\"\\n\",\"user\":true,\"children\":[null,{}]}]");
+
+    json::Reader reader{json.cstring(), json.length()};
+
+    assert(reader.next() == json::Token::BEGIN_ARRAY);
+    assert(reader.next() == json::Token::BEGIN_OBJECT);
+
+    assert(reader.next() == json::Token::KEY);
+    assert(reader.string_is("id"));
+    assert(reader.next() == json::Token::INTEGER);
+    assert(reader.integer() == 1);
+
+    assert(reader.next() == json::Token::KEY);
+    assert(reader.string_is("name"));
+    assert(reader.next() == json::Token::STRING);
+    assert(reader.string() == "system");
+
+    assert(reader.next() == json::Token::KEY);
+    assert(reader.next() == json::Token::FALSE);
+    assert(reader.next() == json::Token::KEY);
+    assert(reader.next() == json::Token::INTEGER);
+    assert(reader.next() == json::Token::END_OBJECT);
+
+    assert(reader.next() == json::Token::BEGIN_OBJECT);
+    assert(reader.next() == json::Token::KEY);
+    assert(reader.next() == json::Token::INTEGER);
+    assert(reader.integer() == -42);
+
+    assert(reader.next() == json::Token::KEY);
+    assert(reader.next() == json::Token::STRING);
+    assert(reader.string() == "say \"hello\"\n");
+
+    assert(reader.next() == json::Token::KEY);
+    assert(reader.next() == json::Token::TRUE);
+    assert(reader.boolean());
+
+    assert(reader.next() == json::Token::KEY);
+    assert(reader.string_is("children"));
+    assert(reader.next() == json::Token::BEGIN_ARRAY);
+    reader.skip();
+
+    assert(reader.next() == json::Token::END_OBJECT);
+    assert(reader.next() == json::Token::END_ARRAY);
+    assert(reader.next() == json::Token::END);
+
+    json::Reader numbers{"[1.5, 2e2, -0.25]", 17};
+
+    assert(numbers.next() == json::Token::BEGIN_ARRAY);
+    assert(numbers.next() == json::Token::DOUBLE && numbers.number() == 1.5);
+    assert(numbers.next() == json::Token::DOUBLE && numbers.number() == 200);
+    assert(numbers.next() == json::Token::DOUBLE && numbers.number() == -0.25);
+    assert(numbers.next() == json::Token::END_ARRAY);
+
+    return 0;
+}
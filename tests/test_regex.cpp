@@ -0,0 +1,75 @@
+#include <stdio.h>
+
+#include <libsystem/Assert.h>
+#include <libsystem/regex/Regex.h>
+
+static bool matches(const char *pattern, const char *text)
+{
+    auto regex = Regex::compile(pattern);
+    assert(regex.success());
+
+    return regex.value()->match(text);
+}
+
+static bool invalid(const char *pattern)
+{
+    return !Regex::compile(pattern).success();
+}
+
+int main(int, char const *[])
+{
+    assert(matches("", ""));
+    assert(matches("", "anything"));
+
+    assert(matches("hello", "hello"));
+    assert(matches("hello", "oh, hello world"));
+    assert(!matches("hello", "hell"));
+
+    assert(matches("^hello", "hello world"));
+    assert(!matches("^hello", "oh, hello"));
+    assert(matches("world$", "hello world"));
+    assert(!matches("world$", "world hello"));
+    assert(matches("^$", ""));
+    assert(!matches("^$", " "));
+
+    assert(matches("h.llo", "hallo"));
+    assert(matches("a*", ""));
+    assert(matches("^a*b$", "aaab"));
+    assert(matches("^a*b$", "b"));
+    assert(!matches("^a+b$", "b"));
+    assert(matches("^a+b$", "ab"));
+    assert(matches("^colou?r$", "color"));
+    assert(matches("^colou?r$", "colour"));
+    assert(!matches("^colou?r$", "colouur"));
+
+    assert(matches("^(cat|dog)s?$", "dogs"));
+    assert(matches("^(cat|dog)s?$", "cat"));
+    assert(!matches("^(cat|dog)s?$", "bird"));
+    assert(matches("a|^b", "xa"));
+    assert(!matches("a|^b", "xb"));
+
+    assert(matches("^[a-c]+$", "abcabc"));
+    assert(!matches("^[a-c]+$", "abcd"));
+    assert(matches("^[^0-9]+$", "abc"));
+    assert(!matches("^[^0-9]+$", "a1c"));
+    assert(matches("[]]", "]"));
+    assert(matches("[a-]", "-"));
+
+    assert(matches("^\\d+$", "12345"));
+    assert(!matches("^\\d+$", "12a45"));
+    assert(matches("^\\w+\\s\\w+$", "hello world"));
+    assert(matches("1\\.5", "1.5"));
+    assert(!matches("1\\.5", "125"));
+
+    // Exponential for a backtracking matcher.
+    assert(!matches("^(a*)*b$", "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"));
+    assert(!matches("a*a*a*a*a*a*a*a*a*a*b", "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"));
+
+    assert(invalid("("));
+    assert(invalid("a)"));
+    assert(invalid("[abc"));
+    assert(invalid("*a"));
+    assert(invalid("a\\"));
+
+    return 0;
+}
@@ -0,0 +1,102 @@
+#include <stdio.h>
+
+#include <libsystem/Assert.h>
+#include <libsystem/Result.h>
+#include <libsystem/core/CString.h>
+#include <libwidget/model/TextModel.h>
+
+Result file_read_all(const char *, void **, size_t *) { return ERR_NO_SUCH_FILE_OR_DIRECTORY; }
+
+static RefPtr<TextModel> model_from(const char *text)
+{
+    Vector<char> content(strlen(text));
+
+    for (size_t i = 0; text[i]; i++)
+    {
+        content.push_back(text[i]);
+    }
+
+    return make<TextModel>(move(content));
+}
+
+static TextCursor cursor_at(TextModel &model, size_t line, size_t column)
+{
+    TextCursor cursor;
+    cursor.move_to_within(model, line);
+    cursor.move_to_within(model.line(line), column);
+
+    return cursor;
+}
+
+int main(int, char const *[])
+{
+    // Multi-byte characters are a single column.
+    auto model = model_from("h\xC3\xA9llo\nwor\xE2\x82\xACld");
+
+    assert(model->line_count() == 2);
+    assert(model->line(0).length() == 5);
+    assert(model->line(0)[1] == U'é');
+    assert(model->line(1).length() == 6);
+    assert(model->line(1)[3] == U'€');
+
+    auto cursor = cursor_at(*model, 0, 2);
+    model->append_at(cursor, U'X');
+    assert(model->line(0).length() == 6);
+    assert(model->line(0)[1] == U'é');
+    assert(model->line(0)[2] == U'X');
+    assert(cursor.column() == 3);
+
+    model->backspace_at(cursor);
+    model->backspace_at(cursor);
+    assert(model->line(0).length() == 4);
+    assert(model->line(0)[1] == U'l');
+    assert(cursor.column() == 1);
+
+    cursor = cursor_at(*model, 1, 3);
+    model->delete_at(cursor);
+    assert(model->line(1).length() == 5);
+    assert(model->line(1)[3] == U'l');
+
+    cursor = cursor_at(*model, 1, 5);
+    model->append_at(cursor, U'€');
+    assert(model->line(1).length() == 6);
+    assert(model->line(1)[5] == U'€');
+
+    // Latin-1, not valid utf8: the lead byte 0xE9 swallows the next two
+    // bytes, editing has to agree with line() on what a column is.
+    model = model_from("\xE9t\xE9\ncaf\xE9");
+
+    assert(model->line(0).length() == 1);
+    assert(model->line(1).length() == 4);
+
+    cursor = cursor_at(*model, 0, 1);
+    model->append_at(cursor, U'x');
+    assert(model->line(0).length() == 2);
+    assert(model->line(0)[1] == U'x');
+
+    model->backspace_at(cursor);
+    assert(model->line(0).length() == 1);
+
+    model->backspace_at(cursor);
+    assert(model->line(0).length() == 0);
+    assert(model->line_count() == 2);
+
+    // A truncated sequence at the end of the line.
+    cursor = cursor_at(*model, 1, 4);
+    model->append_at(cursor, U'!');
+    assert(model->line(1).length() == 4);
+    assert(cursor.column() == 4);
+
+    cursor = cursor_at(*model, 1, 3);
+    model->delete_at(cursor);
+    assert(model->line(1).length() == 3);
+    assert(model->line(1)[2] == U'f');
+
+    cursor = cursor_at(*model, 1, 3);
+    model->newline_at(cursor);
+    assert(model->line_count() == 3);
+    assert(model->line(1).length() == 3);
+    assert(model->line(2).length() == 0);
+
+    return 0;
+}
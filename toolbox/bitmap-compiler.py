@@ -0,0 +1,34 @@
+#!/usr/bin/python3
+
+# Convert any image ImageMagick can read into the raw bitmap format loaded
+# by Bitmap::load_from: a "BMAP" magic, the width and the height as
+# little-endian 32-bit integers, followed by the RGBA pixels.
+
+import struct
+import subprocess
+import sys
+
+BITMAP_MAGIC = b"BMAP"
+
+in_filename = sys.argv[1]
+out_filename = sys.argv[2]
+
+size = subprocess.check_output(
+    ["identify", "-format", "%w %h", in_filename]).decode().split()
+
+width = int(size[0])
+height = int(size[1])
+
+pixels = subprocess.check_output(
+    ["convert", "-background", "none", in_filename, "-depth", "8", "rgba:-"])
+
+if len(pixels) != width * height * 4:
+    sys.exit("bitmap-compiler: unexpected pixel data size for " + in_filename)
+
+outfp = open(out_filename, 'wb')
+
+outfp.write(BITMAP_MAGIC)
+outfp.write(struct.pack("<II", width, height))
+outfp.write(pixels)
+
+outfp.close()